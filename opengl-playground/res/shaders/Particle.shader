@@ -0,0 +1,46 @@
+#shader vertex
+#version 330 core
+
+// Per vertex: corner of the quad. Per instance: the particle, read straight from the simulation buffer
+layout (location = 0) in vec2 a_Corner;
+layout (location = 1) in vec4 a_PositionLife;
+
+out vec2 v_Corner;
+out float v_Life;
+
+uniform mat4 u_MVP;
+uniform float u_Size;
+uniform float u_Lifetime;
+
+void main()
+{
+	// Particles that are not alive collapse into a point and produce no fragments
+	float life = a_PositionLife.w;
+	float size = life > 0.0 ? u_Size : 0.0;
+
+	gl_Position = u_MVP * vec4(a_PositionLife.xyz + vec3(a_Corner * size, 0.0), 1.0);
+	v_Corner = a_Corner;
+	v_Life = clamp(life / u_Lifetime, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+layout (location = 0) out vec4 color;
+
+in vec2 v_Corner;
+in float v_Life;
+
+uniform vec4 u_StartColor;
+uniform vec4 u_EndColor;
+
+void main()
+{
+	// Round particle with a soft edge, fading from start to end color as it ages
+	float falloff = 1.0 - dot(v_Corner, v_Corner) * 4.0;
+	if (falloff <= 0.0)
+		discard;
+
+	color = mix(u_EndColor, u_StartColor, v_Life);
+	color.a *= falloff;
+}
@@ -0,0 +1,63 @@
+#shader vertex
+#version 330 core
+
+// One vertex per particle, captured with transform feedback into the other buffer.
+// A positive life means alive, a negative one is the delay before the first emission.
+layout (location = 0) in vec4 a_PositionLife;
+layout (location = 1) in vec4 a_VelocitySeed;
+
+out vec4 v_PositionLife;
+out vec4 v_VelocitySeed;
+
+uniform float u_DeltaTime;
+uniform int u_Frame;
+uniform vec3 u_EmitterPosition;
+uniform vec3 u_EmitterDirection;
+uniform vec3 u_Gravity;
+uniform float u_Speed;
+uniform float u_Spread;
+uniform float u_Lifetime;
+
+uint Hash(uint x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+float Random(inout uint state)
+{
+	state = Hash(state);
+	return float(state) / 4294967295.0;
+}
+
+void main()
+{
+	vec3 position = a_PositionLife.xyz;
+	float life = a_PositionLife.w;
+	vec3 velocity = a_VelocitySeed.xyz;
+	float seed = a_VelocitySeed.w;
+
+	velocity += u_Gravity * u_DeltaTime;
+	position += velocity * u_DeltaTime;
+
+	bool waiting = life < 0.0;
+	life += waiting ? u_DeltaTime : -u_DeltaTime;
+
+	if (waiting ? life >= 0.0 : life <= 0.0)
+	{
+		uint state = uint(gl_VertexID) * 747796405u + uint(u_Frame) * 2891336453u + uint(seed);
+		vec3 offset = vec3(Random(state), Random(state), Random(state)) * 2.0 - 1.0;
+		vec3 direction = normalize(u_EmitterDirection + offset * u_Spread);
+
+		position = u_EmitterPosition;
+		velocity = direction * u_Speed * (0.5 + 0.5 * Random(state));
+		life = u_Lifetime * (0.5 + 0.5 * Random(state));
+	}
+
+	v_PositionLife = vec4(position, life);
+	v_VelocitySeed = vec4(velocity, seed);
+}
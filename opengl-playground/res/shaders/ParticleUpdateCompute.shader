@@ -0,0 +1,75 @@
+#shader compute
+#version 430 core
+
+// Same simulation as ParticleUpdate.shader, updating the particles in place.
+// A positive life means alive, a negative one is the delay before the first emission.
+layout (local_size_x = 256) in;
+
+struct Particle
+{
+	vec4 positionLife;
+	vec4 velocitySeed;
+};
+
+layout (std430, binding = 0) buffer Particles
+{
+	Particle particles[];
+};
+
+uniform int u_Count;
+uniform float u_DeltaTime;
+uniform int u_Frame;
+uniform vec3 u_EmitterPosition;
+uniform vec3 u_EmitterDirection;
+uniform vec3 u_Gravity;
+uniform float u_Speed;
+uniform float u_Spread;
+uniform float u_Lifetime;
+
+uint Hash(uint x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+float Random(inout uint state)
+{
+	state = Hash(state);
+	return float(state) / 4294967295.0;
+}
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_Count))
+		return;
+
+	vec3 position = particles[index].positionLife.xyz;
+	float life = particles[index].positionLife.w;
+	vec3 velocity = particles[index].velocitySeed.xyz;
+	float seed = particles[index].velocitySeed.w;
+
+	velocity += u_Gravity * u_DeltaTime;
+	position += velocity * u_DeltaTime;
+
+	bool waiting = life < 0.0;
+	life += waiting ? u_DeltaTime : -u_DeltaTime;
+
+	if (waiting ? life >= 0.0 : life <= 0.0)
+	{
+		uint state = index * 747796405u + uint(u_Frame) * 2891336453u + uint(seed);
+		vec3 offset = vec3(Random(state), Random(state), Random(state)) * 2.0 - 1.0;
+		vec3 direction = normalize(u_EmitterDirection + offset * u_Spread);
+
+		position = u_EmitterPosition;
+		velocity = direction * u_Speed * (0.5 + 0.5 * Random(state));
+		life = u_Lifetime * (0.5 + 0.5 * Random(state));
+	}
+
+	particles[index].positionLife = vec4(position, life);
+	particles[index].velocitySeed = vec4(velocity, seed);
+}
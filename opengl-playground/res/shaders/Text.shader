@@ -0,0 +1,40 @@
+#shader vertex
+#version 330 core
+
+layout (location = 0) in vec2 a_Position;
+layout (location = 1) in vec2 a_TexCoord;	// In texels, the atlas might have grown since the glyph was added
+layout (location = 2) in vec4 a_Color;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+
+uniform mat4 u_MVP;
+uniform sampler2D u_Atlas;
+
+void main()
+{
+	gl_Position = u_MVP * vec4(a_Position, 0.0, 1.0);
+	v_TexCoord = a_TexCoord / vec2(textureSize(u_Atlas, 0));
+	v_Color = a_Color;
+}
+
+#shader fragment
+#version 330 core
+
+layout (location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+
+uniform sampler2D u_Atlas;
+
+void main()
+{
+	// The outline sits at 0.5 in the distance field. Smoothing over the screen space
+	// change of the distance keeps the edges antialiased at any text size
+	float distance = texture(u_Atlas, v_TexCoord).r;
+	float width = fwidth(distance);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+
+	color = vec4(v_Color.rgb, v_Color.a * alpha);
+}
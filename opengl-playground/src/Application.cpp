@@ -15,6 +15,10 @@
 #include "VertexBufferLayout.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "TextureManager.h"
+#include "ResourceManager.h"
+#include "ParticleSystem.h"
+#include "TextRenderer.h"
 
 
 int main(void)
@@ -88,23 +92,34 @@ int main(void)
             2, 3, 0,
         };
 
+        // Every GL object lives in the resource manager, which deletes
+        // the destroyed ones in a batch at the end of the frame
+        ResourceManager resources;
+
         // Create a Vertex Array Object
-        VertexArray va;
-        VertexBuffer vb(positions, 4 * 4 * sizeof(float));
-        
+        Handle<VertexArray> va_handle = resources.Create<VertexArray>();
+        Handle<VertexBuffer> vb_handle = resources.Create<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+
+        // Index buffer object
+        Handle<IndexBuffer> ib_handle = resources.Create<IndexBuffer>(indices, 6);
+
+        Handle<Shader> shader_handle = resources.Create<Shader>("res/shaders/Basic.shader");
+
+        // References into a pool are only valid until another resource of the same type is created
+        VertexArray& va = *resources.Get(va_handle);
+        VertexBuffer& vb = *resources.Get(vb_handle);
+        IndexBuffer& ib = *resources.Get(ib_handle);
+        Shader& shader = *resources.Get(shader_handle);
+
         VertexBufferLayout vbl;
         vbl.Push<float>(2);
         vbl.Push<float>(2);
         va.AddBuffer(vb, vbl);
 
-        // Index buffer object
-        IndexBuffer ib(indices, 6);
-
-        Shader shader("res/shaders/Basic.shader");
-
-        Texture texture("res/textures/ronaldinho.png");
+        // Textures are loaded on demand and kept under a 64 MiB VRAM budget
+        TextureManager texture_manager(64 * 1024 * 1024);
         unsigned int slot = 0;
-        texture.Bind(slot);
+        texture_manager.Bind("res/textures/ronaldinho.png", slot);
         shader.SetUniform1i("u_Texture", slot);
         shader.SetUniformMat4f("u_MVP", mvp);
 
@@ -118,11 +133,42 @@ int main(void)
 
         Renderer renderer;
 
+        // A fountain of particles, simulated and drawn without leaving the GPU when possible
+        ParticleEmitterSettings fountain;
+        fountain.Position = glm::vec3(480.0f, 100.0f, 0.0f);
+        fountain.Direction = glm::vec3(0.0f, 1.0f, 0.0f);
+        fountain.Gravity = glm::vec3(0.0f, -300.0f, 0.0f);
+        fountain.Speed = 400.0f;
+        fountain.Spread = 0.35f;
+        fountain.Lifetime = 2.5f;
+        fountain.Size = 2.0f;
+        fountain.StartColor = glm::vec4(1.0f, 0.8f, 0.3f, 1.0f);
+        fountain.EndColor = glm::vec4(0.8f, 0.1f, 0.0f, 0.0f);
+        ParticleSystem particles(1 << 20, fountain);
+
+        // Stats overlay, every label is batched into a single draw call
+        TextRenderer text_renderer("res/fonts/DejaVuSansMono.ttf");
+        const char* simulation_names[] = { "compute shader", "transform feedback", "CPU" };
+        std::string particles_label = "Particles: " + std::to_string(particles.GetCapacity())
+            + " (" + simulation_names[(int)particles.GetSimulation()] + ")";
+        std::string frame_label;
+        double frame_label_time = 0.0;
+        glm::vec4 label_color(1.0f, 1.0f, 1.0f, 0.9f);
+
         glfwSwapInterval(1);
+        double last_time = glfwGetTime();
         
         /* Loop until the user closes the window */
         while (!glfwWindowShouldClose(window))
         {
+            double time = glfwGetTime();
+            float delta_time = (float)(time - last_time);
+            last_time = time;
+
+            texture_manager.BeginFrame();
+            particles.Update(delta_time);
+
+            shader.Bind();
             shader.SetUniformMat4f("u_MVP", mvp);
 
             /* Render here */
@@ -131,9 +177,13 @@ int main(void)
             // Prepare for draw call
             shader.Bind();
 
-            // Draw shape with texture
+            // Draw shape with texture (reloaded here if it was evicted)
+            texture_manager.Bind("res/textures/ronaldinho.png", slot);
             renderer.Draw(va, ib, shader);
 
+            // Particles live in window space, so they only need the projection
+            particles.Draw(renderer, proj);
+
             // Draw shape (Blending example: blend a full opaque red square with a slight 
             // translucid blue one). 
             // NOTE: change the shader code so color = u_Color
@@ -142,6 +192,25 @@ int main(void)
             shader.SetUniform4f("u_Color", 0.0f, 0.0f, 1.0f, 0.4f);
             renderer.Draw(va, ib, shader);*/
 
+            // Refreshing the frame time only twice a second keeps its layout cached in between
+            if (time - frame_label_time > 0.5)
+            {
+                frame_label = "Frame: " + std::to_string((int)(delta_time * 1000.0f + 0.5f)) + " ms";
+                frame_label_time = time;
+            }
+            const TextureStats& texture_stats = texture_manager.GetStats();
+            std::string texture_label = "Textures: " + std::to_string(texture_stats.UsedBytes / (1024 * 1024))
+                + " / " + std::to_string(texture_stats.BudgetBytes / (1024 * 1024)) + " MiB";
+
+            float line_height = text_renderer.GetLineHeight(16.0f);
+            text_renderer.AddText(frame_label, 10.0f, 540.0f - line_height, 16.0f, label_color);
+            text_renderer.AddText(particles_label, 10.0f, 540.0f - 2.0f * line_height, 16.0f, label_color);
+            text_renderer.AddText(texture_label, 10.0f, 540.0f - 3.0f * line_height, 16.0f, label_color);
+            text_renderer.Flush(renderer, proj);
+
+            // Delete the GL objects of the resources destroyed during this frame
+            resources.EndFrame();
+
             /* Swap front and back buffers */
             GLCallVoid(glfwSwapBuffers(window));
 
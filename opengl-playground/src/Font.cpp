@@ -0,0 +1,118 @@
+#include "Font.h"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+// Text is optional: without the stb_truetype header every font is invalid and draws nothing
+#if __has_include(<stb/stb_truetype.h>)
+
+#include <stb/stb_truetype.h>
+
+Font::Font(const std::string& filepath)
+	:	m_emScale(0.0f),
+		m_ascender(0),
+		m_descender(0),
+		m_lineGap(0)
+{
+	std::ifstream file(filepath, std::ios::binary);
+	m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	if (m_data.empty())
+	{
+		std::cout << "Failed to load font " << filepath << ": could not read the file\n";
+		return;
+	}
+
+	std::unique_ptr<stbtt_fontinfo> info(new stbtt_fontinfo());
+	int offset = stbtt_GetFontOffsetForIndex(m_data.data(), 0);
+	if (offset < 0 || !stbtt_InitFont(info.get(), m_data.data(), offset))
+	{
+		std::cout << "Failed to load font " << filepath << ": not a TrueType font\n";
+		return;
+	}
+
+	m_emScale = stbtt_ScaleForMappingEmToPixels(info.get(), 1.0f);
+	stbtt_GetFontVMetrics(info.get(), &m_ascender, &m_descender, &m_lineGap);
+	m_info = std::move(info);
+}
+
+Font::~Font()
+{
+}
+
+int Font::GetGlyphIndex(unsigned int codepoint) const
+{
+	return m_info ? stbtt_FindGlyphIndex(m_info.get(), (int)codepoint) : 0;
+}
+
+float Font::GetAdvance(int glyphIndex) const
+{
+	if (!m_info)
+	{
+		return 0.0f;
+	}
+
+	int advance, left_side_bearing;
+	stbtt_GetGlyphHMetrics(m_info.get(), glyphIndex, &advance, &left_side_bearing);
+	return advance * m_emScale;
+}
+
+std::vector<unsigned char> Font::GetGlyphDistanceField(int glyphIndex, float pixelsPerEm, int spread,
+	int& x0, int& y0, int& width, int& height) const
+{
+	std::vector<unsigned char> field;
+	x0 = y0 = width = height = 0;
+	if (!m_info)
+	{
+		return field;
+	}
+
+	// Every pixel inside the outline adds 128 / spread, so the field saturates `spread` pixels in
+	unsigned char* pixels = stbtt_GetGlyphSDF(m_info.get(), pixelsPerEm * m_emScale, glyphIndex, spread,
+		128, 128.0f / spread, &width, &height, &x0, &y0);
+	if (!pixels)
+	{
+		x0 = y0 = width = height = 0;
+		return field;
+	}
+
+	field.assign(pixels, pixels + width * height);
+	stbtt_FreeSDF(pixels, nullptr);
+	return field;
+}
+
+#else
+
+struct stbtt_fontinfo {};
+
+Font::Font(const std::string& filepath)
+	:	m_emScale(0.0f),
+		m_ascender(0),
+		m_descender(0),
+		m_lineGap(0)
+{
+	std::cout << "Failed to load font " << filepath << ": built without vendor/stb/stb/stb_truetype.h\n";
+}
+
+Font::~Font()
+{
+}
+
+int Font::GetGlyphIndex(unsigned int) const
+{
+	return 0;
+}
+
+float Font::GetAdvance(int) const
+{
+	return 0.0f;
+}
+
+std::vector<unsigned char> Font::GetGlyphDistanceField(int, float, int,
+	int& x0, int& y0, int& width, int& height) const
+{
+	x0 = y0 = width = height = 0;
+	return std::vector<unsigned char>();
+}
+
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct stbtt_fontinfo;
+
+/*
+* @class	Font
+* @brief	TrueType font read with stb_truetype. The file stays in memory for
+*			as long as the font exists, since stb_truetype reads glyphs from it
+*			directly.
+*/
+class Font
+{
+private:
+	std::vector<unsigned char> m_data;
+	std::unique_ptr<stbtt_fontinfo> m_info;
+	float m_emScale;	// Font units to em
+	int m_ascender;
+	int m_descender;
+	int m_lineGap;
+
+public:
+	Font(const std::string& filepath);
+	~Font();
+
+	Font(const Font&) = delete;
+	Font& operator=(const Font&) = delete;
+
+	inline bool IsValid() const { return m_info != nullptr; }
+
+	// Glyph 0, the missing glyph box, when the font has no glyph for the codepoint
+	int GetGlyphIndex(unsigned int codepoint) const;
+	// Horizontal advance of the glyph, in em
+	float GetAdvance(int glyphIndex) const;
+	// Distance between two baselines, in em
+	inline float GetLineHeight() const { return (m_ascender - m_descender + m_lineGap) * m_emScale; }
+
+	/*
+	* Signed distance field of the glyph at `pixelsPerEm`, one byte per pixel and
+	* top row first. 128 lies on the outline and 255 is `spread` pixels inside it.
+	* `x0` and `y0` receive the offset of the top left pixel from the glyph origin,
+	* with y growing down. Glyphs without an outline give an empty field.
+	*/
+	std::vector<unsigned char> GetGlyphDistanceField(int glyphIndex, float pixelsPerEm, int spread,
+		int& x0, int& y0, int& width, int& height) const;
+
+	inline int GetAscender() const { return m_ascender; }
+	inline int GetDescender() const { return m_descender; }
+	inline int GetLineGap() const { return m_lineGap; }
+};
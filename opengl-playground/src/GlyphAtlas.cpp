@@ -0,0 +1,161 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "Renderer.h"
+
+// Empty texels between glyphs, so linear filtering does not bleed into the neighbours
+static const int s_glyphPadding = 1;
+
+GlyphAtlas::GlyphAtlas(const Font& font, int glyphSize, int spread, int width)
+	:	m_rendererId(0),
+		m_font(&font),
+		m_glyphSize(glyphSize),
+		m_spread(spread),
+		m_width(width),
+		m_height(glyphSize * 2),
+		m_maxHeight(0),
+		m_pixels(width * glyphSize * 2, 0),
+		m_shelfX(0),
+		m_shelfY(0),
+		m_shelfHeight(0)
+{
+	GLCallVoid(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &m_maxHeight));
+
+	GLCallVoid(glGenTextures(1, &m_rendererId));
+	GLCallVoid(glBindTexture(GL_TEXTURE_2D, m_rendererId));
+
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+	// Rows of a single channel texture are rarely a multiple of 4 bytes
+	GLCallVoid(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+	GLCallVoid(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_width, m_height, 0,
+		GL_RED, GL_UNSIGNED_BYTE, m_pixels.data()));
+	GLCallVoid(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+	GLCallVoid(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	GLCallVoid(glDeleteTextures(1, &m_rendererId));
+}
+
+const AtlasGlyph& GlyphAtlas::GetGlyph(unsigned int codepoint)
+{
+	auto search = m_glyphs.find(codepoint);
+	if (search != m_glyphs.end())
+	{
+		return search->second;
+	}
+
+	int glyph_index = m_font->GetGlyphIndex(codepoint);
+	float em = (float)m_glyphSize;
+
+	AtlasGlyph glyph = {};
+	glyph.Advance = m_font->GetAdvance(glyph_index);
+
+	int x0, y0, width, height;
+	std::vector<unsigned char> field = m_font->GetGlyphDistanceField(glyph_index, em, m_spread, x0, y0, width, height);
+	if (!field.empty())
+	{
+		int x, y;
+		if (m_Allocate(width, height, x, y))
+		{
+			for (int row = 0; row < height; row++)
+			{
+				std::copy(field.begin() + row * width, field.begin() + (row + 1) * width,
+					m_pixels.begin() + (y + row) * m_width + x);
+			}
+
+			GLCallVoid(glBindTexture(GL_TEXTURE_2D, m_rendererId));
+			GLCallVoid(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+			GLCallVoid(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height,
+				GL_RED, GL_UNSIGNED_BYTE, field.data()));
+			GLCallVoid(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+			GLCallVoid(glBindTexture(GL_TEXTURE_2D, 0));
+
+			// The field starts with its top row, `y0` pixels below the baseline (y grows down)
+			glyph.X0 = x0 / em;
+			glyph.Y0 = -(y0 + height) / em;
+			glyph.X1 = (x0 + width) / em;
+			glyph.Y1 = -y0 / em;
+			glyph.U0 = (float)x;
+			glyph.V0 = (float)(y + height);
+			glyph.U1 = (float)(x + width);
+			glyph.V1 = (float)y;
+		}
+		else
+		{
+			std::cout << "Glyph atlas is full, codepoint " << codepoint << " will not be drawn\n";
+		}
+	}
+
+	return m_glyphs.emplace(codepoint, glyph).first->second;
+}
+
+void GlyphAtlas::Bind(unsigned int slot) const
+{
+	GLCallVoid(glActiveTexture(GL_TEXTURE0 + slot));
+	GLCallVoid(glBindTexture(GL_TEXTURE_2D, m_rendererId));
+}
+
+void GlyphAtlas::Unbind() const
+{
+	GLCallVoid(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+bool GlyphAtlas::m_Allocate(int width, int height, int& x, int& y)
+{
+	int padded_width = width + s_glyphPadding;
+	int padded_height = height + s_glyphPadding;
+	if (padded_width > m_width)
+	{
+		return false;
+	}
+
+	// Start a new shelf when the glyph does not fit in the current one
+	if (m_shelfX + padded_width > m_width)
+	{
+		m_shelfY += m_shelfHeight;
+		m_shelfX = 0;
+		m_shelfHeight = 0;
+	}
+
+	while (m_shelfY + padded_height > m_height)
+	{
+		if (!m_Grow())
+		{
+			return false;
+		}
+	}
+
+	x = m_shelfX;
+	y = m_shelfY;
+	m_shelfX += padded_width;
+	m_shelfHeight = std::max(m_shelfHeight, padded_height);
+	return true;
+}
+
+bool GlyphAtlas::m_Grow()
+{
+	if (m_height * 2 > m_maxHeight)
+	{
+		return false;
+	}
+
+	// New rows go after the old ones, so every glyph keeps its texel coordinates
+	m_height *= 2;
+	m_pixels.resize(m_width * m_height, 0);
+
+	GLCallVoid(glBindTexture(GL_TEXTURE_2D, m_rendererId));
+	GLCallVoid(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+	GLCallVoid(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_width, m_height, 0,
+		GL_RED, GL_UNSIGNED_BYTE, m_pixels.data()));
+	GLCallVoid(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+	GLCallVoid(glBindTexture(GL_TEXTURE_2D, 0));
+	return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Font.h"
+
+struct AtlasGlyph
+{
+	// Quad relative to the pen position, in em
+	float X0;
+	float Y0;
+	float X1;
+	float Y1;
+	// Rectangle in the atlas, in texels, so it survives the atlas growing
+	float U0;
+	float V0;
+	float U1;
+	float V1;
+	float Advance;
+};
+
+/*
+* @class	GlyphAtlas
+* @brief	Single channel texture holding the signed distance fields of the
+*			glyphs used so far. Glyphs are rasterized once, the first time they
+*			are requested, and packed in shelves. When the atlas is full it
+*			doubles its height, keeping the glyphs where they already are.
+*/
+class GlyphAtlas
+{
+private:
+	unsigned int m_rendererId;
+	const Font* m_font;
+	int m_glyphSize;	// Pixels per em the distance fields are rasterized at
+	int m_spread;		// Distance in pixels covered by the field around the outline
+	int m_width;
+	int m_height;
+	int m_maxHeight;
+	std::vector<unsigned char> m_pixels;
+	int m_shelfX;
+	int m_shelfY;
+	int m_shelfHeight;
+	std::unordered_map<unsigned int, AtlasGlyph> m_glyphs;
+
+public:
+	GlyphAtlas(const Font& font, int glyphSize = 32, int spread = 4, int width = 512);
+	~GlyphAtlas();
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+	const AtlasGlyph& GetGlyph(unsigned int codepoint);
+
+	void Bind(unsigned int slot = 0) const;
+	void Unbind() const;
+
+	inline int GetWidth() const { return m_width; }
+	inline int GetHeight() const { return m_height; }
+	inline int GetSpread() const { return m_spread; }
+	inline int GetGlyphSize() const { return m_glyphSize; }
+	inline size_t GetGlyphCount() const { return m_glyphs.size(); }
+
+private:
+	bool m_Allocate(int width, int height, int& x, int& y);
+	bool m_Grow();
+};
@@ -19,7 +19,38 @@ IndexBuffer::IndexBuffer(const unsigned int* indices, unsigned int count)
 
 IndexBuffer::~IndexBuffer()
 {
-    GLCallVoid(glDeleteBuffers(1, &m_rendererId));
+    if (m_rendererId)
+    {
+        GLCallVoid(glDeleteBuffers(1, &m_rendererId));
+    }
+}
+
+IndexBuffer::IndexBuffer(IndexBuffer&& other) noexcept
+    :   m_count(other.m_count)
+{
+    m_rendererId = other.Release();
+}
+
+IndexBuffer& IndexBuffer::operator=(IndexBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_rendererId)
+        {
+            GLCallVoid(glDeleteBuffers(1, &m_rendererId));
+        }
+        m_count = other.m_count;
+        m_rendererId = other.Release();
+    }
+    return *this;
+}
+
+unsigned int IndexBuffer::Release()
+{
+    unsigned int id = m_rendererId;
+    m_rendererId = 0;
+    m_count = 0;
+    return id;
 }
 
 void IndexBuffer::Bind() const
@@ -10,6 +10,15 @@ public:
 	IndexBuffer(const unsigned int* indices, unsigned int count);
 	~IndexBuffer();
 
+	IndexBuffer(const IndexBuffer&) = delete;
+	IndexBuffer& operator=(const IndexBuffer&) = delete;
+	IndexBuffer(IndexBuffer&& other) noexcept;
+	IndexBuffer& operator=(IndexBuffer&& other) noexcept;
+
+	// Gives up ownership of the GL buffer, so it can be deleted somewhere else
+	unsigned int Release();
+	inline unsigned int GetRendererId() const { return m_rendererId; }
+
 	void Bind() const;
 	void Unbind() const;
 
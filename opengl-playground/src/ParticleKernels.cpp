@@ -0,0 +1,281 @@
+#include "ParticleKernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define PARTICLE_KERNELS_X64
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define AVX2_TARGET
+	#else
+		#include <cpuid.h>
+		// GCC and Clang only emit AVX instructions in functions marked for it
+		#define AVX2_TARGET __attribute__((target("avx2")))
+	#endif
+#endif
+
+void ParticleArrays::Resize(size_t count)
+{
+	PositionX.resize(count);
+	PositionY.resize(count);
+	PositionZ.resize(count);
+	VelocityX.resize(count);
+	VelocityY.resize(count);
+	VelocityZ.resize(count);
+	Life.resize(count);
+}
+
+SimdLevel DetectSimdLevel()
+{
+#ifdef PARTICLE_KERNELS_X64
+	// SSE2 is part of x64, AVX2 needs both the CPU and the OS (which saves the YMM registers)
+	unsigned int leaf1[4] = { 0 };
+	unsigned int leaf7[4] = { 0 };
+#if defined(_MSC_VER)
+	__cpuid((int*)leaf1, 1);
+	__cpuidex((int*)leaf7, 7, 0);
+#else
+	__cpuid(1, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+	__cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+#endif
+
+	bool os_saves_ymm = false;
+	if (leaf1[2] & (1u << 27))	// OSXSAVE
+	{
+#if defined(_MSC_VER)
+		unsigned long long xcr0 = _xgetbv(0);
+#else
+		unsigned int eax, edx;
+		__asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		unsigned long long xcr0 = ((unsigned long long)edx << 32) | eax;
+#endif
+		os_saves_ymm = (xcr0 & 0x6) == 0x6;
+	}
+
+	bool has_avx = (leaf1[2] & (1u << 28)) != 0;
+	bool has_avx2 = (leaf7[1] & (1u << 5)) != 0;
+	if (os_saves_ymm && has_avx && has_avx2)
+	{
+		return SimdLevel::AVX2;
+	}
+	return SimdLevel::SSE;
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+const char* GetSimdLevelName(SimdLevel level)
+{
+	switch (level)
+	{
+		case SimdLevel::Scalar:	return "Scalar";
+		case SimdLevel::SSE:	return "SSE";
+		case SimdLevel::AVX2:	return "AVX2";
+	}
+	return "Unknown";
+}
+
+static size_t IntegrateRangeScalar(ParticleArrays& particles, const ParticleStepParams& params,
+	size_t begin, size_t end, uint32_t* respawned, size_t respawnedCount)
+{
+	float dt = params.DeltaTime;
+	for (size_t i = begin; i < end; i++)
+	{
+		particles.VelocityX[i] += params.GravityX * dt;
+		particles.VelocityY[i] += params.GravityY * dt;
+		particles.VelocityZ[i] += params.GravityZ * dt;
+		particles.PositionX[i] += particles.VelocityX[i] * dt;
+		particles.PositionY[i] += particles.VelocityY[i] * dt;
+		particles.PositionZ[i] += particles.VelocityZ[i] * dt;
+
+		float life = particles.Life[i];
+		bool waiting = life < 0.0f;
+		life += waiting ? dt : -dt;
+		particles.Life[i] = life;
+
+		if (waiting ? life >= 0.0f : life <= 0.0f)
+		{
+			respawned[respawnedCount++] = (uint32_t)i;
+		}
+	}
+	return respawnedCount;
+}
+
+#ifdef PARTICLE_KERNELS_X64
+
+static size_t IntegrateSSE(ParticleArrays& particles, const ParticleStepParams& params, uint32_t* respawned)
+{
+	size_t count = particles.GetCount();
+	size_t simd_count = count & ~(size_t)3;
+	size_t respawned_count = 0;
+
+	float* px = particles.PositionX.data();
+	float* py = particles.PositionY.data();
+	float* pz = particles.PositionZ.data();
+	float* vx = particles.VelocityX.data();
+	float* vy = particles.VelocityY.data();
+	float* vz = particles.VelocityZ.data();
+	float* life = particles.Life.data();
+
+	const __m128 dt = _mm_set1_ps(params.DeltaTime);
+	const __m128 minus_dt = _mm_set1_ps(-params.DeltaTime);
+	const __m128 gx = _mm_set1_ps(params.GravityX * params.DeltaTime);
+	const __m128 gy = _mm_set1_ps(params.GravityY * params.DeltaTime);
+	const __m128 gz = _mm_set1_ps(params.GravityZ * params.DeltaTime);
+	const __m128 zero = _mm_setzero_ps();
+
+	for (size_t i = 0; i < simd_count; i += 4)
+	{
+		__m128 x_velocity = _mm_add_ps(_mm_loadu_ps(vx + i), gx);
+		__m128 y_velocity = _mm_add_ps(_mm_loadu_ps(vy + i), gy);
+		__m128 z_velocity = _mm_add_ps(_mm_loadu_ps(vz + i), gz);
+		_mm_storeu_ps(vx + i, x_velocity);
+		_mm_storeu_ps(vy + i, y_velocity);
+		_mm_storeu_ps(vz + i, z_velocity);
+		_mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(x_velocity, dt)));
+		_mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(y_velocity, dt)));
+		_mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(z_velocity, dt)));
+
+		// Waiting particles count up to zero, living ones count down to it
+		__m128 old_life = _mm_loadu_ps(life + i);
+		__m128 waiting = _mm_cmplt_ps(old_life, zero);
+		__m128 step = _mm_or_ps(_mm_and_ps(waiting, dt), _mm_andnot_ps(waiting, minus_dt));
+		__m128 new_life = _mm_add_ps(old_life, step);
+		_mm_storeu_ps(life + i, new_life);
+
+		__m128 respawn = _mm_or_ps(_mm_and_ps(waiting, _mm_cmpge_ps(new_life, zero)),
+			_mm_andnot_ps(waiting, _mm_cmple_ps(new_life, zero)));
+		int mask = _mm_movemask_ps(respawn);
+		if (mask)
+		{
+			for (int lane = 0; lane < 4; lane++)
+			{
+				if (mask & (1 << lane))
+				{
+					respawned[respawned_count++] = (uint32_t)(i + lane);
+				}
+			}
+		}
+	}
+
+	return IntegrateRangeScalar(particles, params, simd_count, count, respawned, respawned_count);
+}
+
+AVX2_TARGET
+static size_t IntegrateAVX2(ParticleArrays& particles, const ParticleStepParams& params, uint32_t* respawned)
+{
+	size_t count = particles.GetCount();
+	size_t simd_count = count & ~(size_t)7;
+	size_t respawned_count = 0;
+
+	float* px = particles.PositionX.data();
+	float* py = particles.PositionY.data();
+	float* pz = particles.PositionZ.data();
+	float* vx = particles.VelocityX.data();
+	float* vy = particles.VelocityY.data();
+	float* vz = particles.VelocityZ.data();
+	float* life = particles.Life.data();
+
+	const __m256 dt = _mm256_set1_ps(params.DeltaTime);
+	const __m256 minus_dt = _mm256_set1_ps(-params.DeltaTime);
+	const __m256 gx = _mm256_set1_ps(params.GravityX * params.DeltaTime);
+	const __m256 gy = _mm256_set1_ps(params.GravityY * params.DeltaTime);
+	const __m256 gz = _mm256_set1_ps(params.GravityZ * params.DeltaTime);
+	const __m256 zero = _mm256_setzero_ps();
+
+	for (size_t i = 0; i < simd_count; i += 8)
+	{
+		__m256 x_velocity = _mm256_add_ps(_mm256_loadu_ps(vx + i), gx);
+		__m256 y_velocity = _mm256_add_ps(_mm256_loadu_ps(vy + i), gy);
+		__m256 z_velocity = _mm256_add_ps(_mm256_loadu_ps(vz + i), gz);
+		_mm256_storeu_ps(vx + i, x_velocity);
+		_mm256_storeu_ps(vy + i, y_velocity);
+		_mm256_storeu_ps(vz + i, z_velocity);
+		_mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(x_velocity, dt)));
+		_mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(y_velocity, dt)));
+		_mm256_storeu_ps(pz + i, _mm256_add_ps(_mm256_loadu_ps(pz + i), _mm256_mul_ps(z_velocity, dt)));
+
+		__m256 old_life = _mm256_loadu_ps(life + i);
+		__m256 waiting = _mm256_cmp_ps(old_life, zero, _CMP_LT_OQ);
+		__m256 new_life = _mm256_add_ps(old_life, _mm256_blendv_ps(minus_dt, dt, waiting));
+		_mm256_storeu_ps(life + i, new_life);
+
+		__m256 respawn = _mm256_blendv_ps(_mm256_cmp_ps(new_life, zero, _CMP_LE_OQ),
+			_mm256_cmp_ps(new_life, zero, _CMP_GE_OQ), waiting);
+		int mask = _mm256_movemask_ps(respawn);
+		if (mask)
+		{
+			for (int lane = 0; lane < 8; lane++)
+			{
+				if (mask & (1 << lane))
+				{
+					respawned[respawned_count++] = (uint32_t)(i + lane);
+				}
+			}
+		}
+	}
+
+	return IntegrateRangeScalar(particles, params, simd_count, count, respawned, respawned_count);
+}
+
+static void PackPositionLifeSSE(const ParticleArrays& particles, float* out)
+{
+	size_t count = particles.GetCount();
+	size_t simd_count = count & ~(size_t)3;
+
+	// Four particles at a time: their x, y, z and life rows become four xyzw columns
+	for (size_t i = 0; i < simd_count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(particles.PositionX.data() + i);
+		__m128 y = _mm_loadu_ps(particles.PositionY.data() + i);
+		__m128 z = _mm_loadu_ps(particles.PositionZ.data() + i);
+		__m128 w = _mm_loadu_ps(particles.Life.data() + i);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(out + i * 4 + 0, x);
+		_mm_storeu_ps(out + i * 4 + 4, y);
+		_mm_storeu_ps(out + i * 4 + 8, z);
+		_mm_storeu_ps(out + i * 4 + 12, w);
+	}
+
+	for (size_t i = simd_count; i < count; i++)
+	{
+		out[i * 4 + 0] = particles.PositionX[i];
+		out[i * 4 + 1] = particles.PositionY[i];
+		out[i * 4 + 2] = particles.PositionZ[i];
+		out[i * 4 + 3] = particles.Life[i];
+	}
+}
+
+#endif
+
+size_t IntegrateParticles(SimdLevel level, ParticleArrays& particles,
+	const ParticleStepParams& params, uint32_t* respawned)
+{
+#ifdef PARTICLE_KERNELS_X64
+	switch (level)
+	{
+		case SimdLevel::AVX2:	return IntegrateAVX2(particles, params, respawned);
+		case SimdLevel::SSE:	return IntegrateSSE(particles, params, respawned);
+		default:				break;
+	}
+#endif
+	return IntegrateRangeScalar(particles, params, 0, particles.GetCount(), respawned, 0);
+}
+
+void PackParticlePositionLife(SimdLevel level, const ParticleArrays& particles, float* out)
+{
+#ifdef PARTICLE_KERNELS_X64
+	// The transpose is bound by memory, 8 wide registers would not make it any faster
+	if (level != SimdLevel::Scalar)
+	{
+		PackPositionLifeSSE(particles, out);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < particles.GetCount(); i++)
+	{
+		out[i * 4 + 0] = particles.PositionX[i];
+		out[i * 4 + 1] = particles.PositionY[i];
+		out[i * 4 + 2] = particles.PositionZ[i];
+		out[i * 4 + 3] = particles.Life[i];
+	}
+}
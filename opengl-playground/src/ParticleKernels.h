@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+* CPU particle simulation, used when the context can do neither compute
+* shaders nor transform feedback. Nothing in here touches OpenGL, so the
+* kernels can be benchmarked on their own.
+*
+* A particle with positive life is alive. A negative life is a delay before
+* the particle is emitted for the first time. Particles are reported for
+* respawn when their life runs out or their delay is over.
+*/
+
+enum class SimdLevel
+{
+	Scalar = 0, SSE = 1, AVX2 = 2,
+};
+
+// Structure of arrays, so the kernels load 4 or 8 particles per instruction
+struct ParticleArrays
+{
+	std::vector<float> PositionX;
+	std::vector<float> PositionY;
+	std::vector<float> PositionZ;
+	std::vector<float> VelocityX;
+	std::vector<float> VelocityY;
+	std::vector<float> VelocityZ;
+	std::vector<float> Life;
+
+	void Resize(size_t count);
+	inline size_t GetCount() const { return Life.size(); }
+};
+
+struct ParticleStepParams
+{
+	float DeltaTime;
+	float GravityX;
+	float GravityY;
+	float GravityZ;
+};
+
+SimdLevel DetectSimdLevel();
+const char* GetSimdLevelName(SimdLevel level);
+
+/*
+* Advances every particle by one step and writes the indices of the particles
+* that must be respawned to `respawned`, which needs room for all of them.
+* Returns how many indices were written.
+*/
+size_t IntegrateParticles(SimdLevel level, ParticleArrays& particles,
+	const ParticleStepParams& params, uint32_t* respawned);
+
+/*
+* Interleaves position and life as 4 floats per particle, the layout the
+* particle shader reads its instances from. `out` needs 4 floats per particle.
+*/
+void PackParticlePositionLife(SimdLevel level, const ParticleArrays& particles, float* out);
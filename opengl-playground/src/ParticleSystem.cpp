@@ -0,0 +1,251 @@
+#include "ParticleSystem.h"
+
+#include <iostream>
+
+#include "VertexBufferLayout.h"
+
+// Two triangles covering a unit quad centered at the origin
+static const float s_quadCorners[] = {
+	-0.5f, -0.5f,
+	 0.5f, -0.5f,
+	 0.5f,  0.5f,
+	 0.5f,  0.5f,
+	-0.5f,  0.5f,
+	-0.5f, -0.5f,
+};
+
+// Position and life, then velocity and random seed
+static const unsigned int s_gpuParticleFloats = 8;
+
+ParticleSystem::ParticleSystem(unsigned int capacity, const ParticleEmitterSettings& settings)
+	:	ParticleSystem(capacity, settings, GetBestSimulation())
+{
+}
+
+ParticleSystem::ParticleSystem(unsigned int capacity, const ParticleEmitterSettings& settings, ParticleSimulation simulation)
+	:	m_capacity(capacity),
+		m_simulation(simulation),
+		m_settings(settings),
+		m_frame(0),
+		m_current(0),
+		m_quad(s_quadCorners, sizeof(s_quadCorners)),
+		m_drawShader("res/shaders/Particle.shader"),
+		m_simdLevel(SimdLevel::Scalar),
+		m_randomState(0x9E3779B9u)
+{
+	if (m_simulation == ParticleSimulation::CPU)
+	{
+		m_InitCPU();
+	}
+	else
+	{
+		m_InitGPU();
+	}
+}
+
+ParticleSimulation ParticleSystem::GetBestSimulation()
+{
+	if (GLEW_VERSION_4_3)
+	{
+		return ParticleSimulation::ComputeShader;
+	}
+	if (GLEW_VERSION_3_0)
+	{
+		return ParticleSimulation::TransformFeedback;
+	}
+	return ParticleSimulation::CPU;
+}
+
+void ParticleSystem::m_InitGPU()
+{
+	// Every particle starts waiting at the emitter for a random delay, so they
+	// are not all emitted in the same frame
+	std::vector<float> initial(m_capacity * s_gpuParticleFloats);
+	for (unsigned int i = 0; i < m_capacity; i++)
+	{
+		float* particle = &initial[i * s_gpuParticleFloats];
+		particle[0] = m_settings.Position.x;
+		particle[1] = m_settings.Position.y;
+		particle[2] = m_settings.Position.z;
+		particle[3] = -m_Random() * m_settings.Lifetime;
+		particle[4] = 0.0f;
+		particle[5] = 0.0f;
+		particle[6] = 0.0f;
+		particle[7] = (float)(uint32_t)(m_Random() * 65535.0f);
+	}
+
+	unsigned int size = m_capacity * s_gpuParticleFloats * sizeof(float);
+	VertexBufferLayout state_layout;
+	state_layout.Push<float>(4);
+	state_layout.Push<float>(4);
+	VertexBufferLayout quad_layout;
+	quad_layout.Push<float>(2);
+
+	// The compute shader updates its buffer in place, transform feedback
+	// reads one buffer and writes the other, swapping them every frame
+	unsigned int buffer_count = m_simulation == ParticleSimulation::ComputeShader ? 1 : 2;
+	m_stateBuffers.reserve(buffer_count);
+	m_updateArrays.reserve(buffer_count);
+	m_drawArrays.reserve(buffer_count);
+	for (unsigned int i = 0; i < buffer_count; i++)
+	{
+		m_stateBuffers.emplace_back(initial.data(), size, GL_DYNAMIC_COPY);
+
+		m_drawArrays.emplace_back();
+		m_drawArrays.back().AddBuffer(m_quad, quad_layout);
+		m_drawArrays.back().AddBuffer(m_stateBuffers.back(), state_layout, 1, 1);
+
+		if (m_simulation == ParticleSimulation::TransformFeedback)
+		{
+			m_updateArrays.emplace_back();
+			m_updateArrays.back().AddBuffer(m_stateBuffers.back(), state_layout);
+		}
+	}
+	m_drawArrays.back().Unbind();
+
+	if (m_simulation == ParticleSimulation::ComputeShader)
+	{
+		m_updateShader = std::make_unique<Shader>("res/shaders/ParticleUpdateCompute.shader");
+	}
+	else
+	{
+		m_updateShader = std::make_unique<Shader>("res/shaders/ParticleUpdate.shader",
+			std::vector<std::string>{ "v_PositionLife", "v_VelocitySeed" });
+	}
+}
+
+void ParticleSystem::m_InitCPU()
+{
+	m_simdLevel = DetectSimdLevel();
+	std::cout << "Simulating particles on the CPU with " << GetSimdLevelName(m_simdLevel) << "\n";
+
+	m_particles.Resize(m_capacity);
+	for (unsigned int i = 0; i < m_capacity; i++)
+	{
+		m_particles.PositionX[i] = m_settings.Position.x;
+		m_particles.PositionY[i] = m_settings.Position.y;
+		m_particles.PositionZ[i] = m_settings.Position.z;
+		m_particles.Life[i] = -m_Random() * m_settings.Lifetime;
+	}
+	m_respawned.resize(m_capacity);
+	m_staging.resize(m_capacity * 4);
+
+	// Only position and life are uploaded, that is all the particle shader reads
+	VertexBufferLayout state_layout;
+	state_layout.Push<float>(4);
+	VertexBufferLayout quad_layout;
+	quad_layout.Push<float>(2);
+
+	m_stateBuffers.emplace_back(nullptr, m_capacity * 4 * sizeof(float), GL_STREAM_DRAW);
+	m_drawArrays.emplace_back();
+	m_drawArrays.back().AddBuffer(m_quad, quad_layout);
+	m_drawArrays.back().AddBuffer(m_stateBuffers.back(), state_layout, 1, 1);
+	m_drawArrays.back().Unbind();
+}
+
+void ParticleSystem::Update(float deltaTime)
+{
+	switch (m_simulation)
+	{
+		case ParticleSimulation::ComputeShader:		m_UpdateCompute(deltaTime); break;
+		case ParticleSimulation::TransformFeedback:	m_UpdateTransformFeedback(deltaTime); break;
+		case ParticleSimulation::CPU:				m_UpdateCPU(deltaTime); break;
+	}
+	m_frame++;
+}
+
+void ParticleSystem::Draw(Renderer& renderer, const glm::mat4& mvp)
+{
+	m_drawShader.Bind();
+	m_drawShader.SetUniformMat4f("u_MVP", mvp);
+	m_drawShader.SetUniform1f("u_Size", m_settings.Size);
+	m_drawShader.SetUniform1f("u_Lifetime", m_settings.Lifetime);
+	m_drawShader.SetUniform4f("u_StartColor", m_settings.StartColor.r, m_settings.StartColor.g,
+		m_settings.StartColor.b, m_settings.StartColor.a);
+	m_drawShader.SetUniform4f("u_EndColor", m_settings.EndColor.r, m_settings.EndColor.g,
+		m_settings.EndColor.b, m_settings.EndColor.a);
+
+	renderer.DrawInstanced(m_drawArrays[m_current], 6, m_capacity, m_drawShader);
+}
+
+void ParticleSystem::m_UpdateCompute(float deltaTime)
+{
+	m_updateShader->Bind();
+	m_SetSimulationUniforms(deltaTime);
+	m_updateShader->SetUniform1i("u_Count", (int)m_capacity);
+
+	GLCallVoid(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_stateBuffers[0].GetRendererId()));
+	GLCallVoid(glDispatchCompute((m_capacity + 255) / 256, 1, 1));
+
+	// The draw call reads the particles back as instanced vertex attributes
+	GLCallVoid(glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT));
+}
+
+void ParticleSystem::m_UpdateTransformFeedback(float deltaTime)
+{
+	unsigned int next = 1 - m_current;
+
+	m_updateShader->Bind();
+	m_SetSimulationUniforms(deltaTime);
+
+	// Every particle goes through the vertex shader once and nothing gets rasterized
+	GLCallVoid(glEnable(GL_RASTERIZER_DISCARD));
+	m_updateArrays[m_current].Bind();
+	GLCallVoid(glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, m_stateBuffers[next].GetRendererId()));
+	GLCallVoid(glBeginTransformFeedback(GL_POINTS));
+	GLCallVoid(glDrawArrays(GL_POINTS, 0, m_capacity));
+	GLCallVoid(glEndTransformFeedback());
+	GLCallVoid(glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0));
+	GLCallVoid(glDisable(GL_RASTERIZER_DISCARD));
+
+	m_current = next;
+}
+
+void ParticleSystem::m_UpdateCPU(float deltaTime)
+{
+	ParticleStepParams params = { deltaTime, m_settings.Gravity.x, m_settings.Gravity.y, m_settings.Gravity.z };
+	size_t respawned_count = IntegrateParticles(m_simdLevel, m_particles, params, m_respawned.data());
+	for (size_t i = 0; i < respawned_count; i++)
+	{
+		m_Respawn(m_respawned[i]);
+	}
+
+	PackParticlePositionLife(m_simdLevel, m_particles, m_staging.data());
+	m_stateBuffers[0].SetData(m_staging.data(), (unsigned int)(m_staging.size() * sizeof(float)));
+}
+
+void ParticleSystem::m_SetSimulationUniforms(float deltaTime)
+{
+	m_updateShader->SetUniform1f("u_DeltaTime", deltaTime);
+	m_updateShader->SetUniform1i("u_Frame", m_frame);
+	m_updateShader->SetUniform3f("u_EmitterPosition", m_settings.Position.x, m_settings.Position.y, m_settings.Position.z);
+	m_updateShader->SetUniform3f("u_EmitterDirection", m_settings.Direction.x, m_settings.Direction.y, m_settings.Direction.z);
+	m_updateShader->SetUniform3f("u_Gravity", m_settings.Gravity.x, m_settings.Gravity.y, m_settings.Gravity.z);
+	m_updateShader->SetUniform1f("u_Speed", m_settings.Speed);
+	m_updateShader->SetUniform1f("u_Spread", m_settings.Spread);
+	m_updateShader->SetUniform1f("u_Lifetime", m_settings.Lifetime);
+}
+
+void ParticleSystem::m_Respawn(uint32_t index)
+{
+	glm::vec3 offset(m_Random() * 2.0f - 1.0f, m_Random() * 2.0f - 1.0f, m_Random() * 2.0f - 1.0f);
+	glm::vec3 direction = glm::normalize(m_settings.Direction + offset * m_settings.Spread);
+	glm::vec3 velocity = direction * m_settings.Speed * (0.5f + 0.5f * m_Random());
+
+	m_particles.PositionX[index] = m_settings.Position.x;
+	m_particles.PositionY[index] = m_settings.Position.y;
+	m_particles.PositionZ[index] = m_settings.Position.z;
+	m_particles.VelocityX[index] = velocity.x;
+	m_particles.VelocityY[index] = velocity.y;
+	m_particles.VelocityZ[index] = velocity.z;
+	m_particles.Life[index] = m_settings.Lifetime * (0.5f + 0.5f * m_Random());
+}
+
+float ParticleSystem::m_Random()
+{
+	// xorshift32, plenty for scattering particles
+	m_randomState ^= m_randomState << 13;
+	m_randomState ^= m_randomState >> 17;
+	m_randomState ^= m_randomState << 5;
+	return (float)(m_randomState >> 8) / 16777216.0f;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ParticleKernels.h"
+#include "Renderer.h"
+#include "Shader.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+struct ParticleEmitterSettings
+{
+	glm::vec3 Position;
+	glm::vec3 Direction;
+	glm::vec3 Gravity;
+	float Speed;
+	float Spread;
+	float Lifetime;
+	float Size;
+	glm::vec4 StartColor;
+	glm::vec4 EndColor;
+};
+
+enum class ParticleSimulation
+{
+	ComputeShader, TransformFeedback, CPU,
+};
+
+/*
+* @class	ParticleSystem
+* @brief	One emitter with a fixed number of particles, which respawn at the
+*			emitter when they die. The simulation runs on the GPU when the
+*			context allows it (compute shader from GL 4.3, transform feedback
+*			otherwise) and the particles are drawn with instancing straight from
+*			the simulation buffer, without reading anything back. As a fallback,
+*			the particles are simulated with SIMD on the CPU and uploaded every frame.
+*/
+class ParticleSystem
+{
+private:
+	unsigned int m_capacity;
+	ParticleSimulation m_simulation;
+	ParticleEmitterSettings m_settings;
+	int m_frame;
+	unsigned int m_current;		// Index of the state buffer holding the latest particles
+
+	VertexBuffer m_quad;
+	std::vector<VertexBuffer> m_stateBuffers;
+	std::vector<VertexArray> m_updateArrays;
+	std::vector<VertexArray> m_drawArrays;
+	Shader m_drawShader;
+	std::unique_ptr<Shader> m_updateShader;
+
+	// Only used by the CPU simulation
+	SimdLevel m_simdLevel;
+	ParticleArrays m_particles;
+	std::vector<uint32_t> m_respawned;
+	std::vector<float> m_staging;
+	uint32_t m_randomState;
+
+public:
+	ParticleSystem(unsigned int capacity, const ParticleEmitterSettings& settings);
+	ParticleSystem(unsigned int capacity, const ParticleEmitterSettings& settings, ParticleSimulation simulation);
+
+	// Best simulation the current context supports
+	static ParticleSimulation GetBestSimulation();
+
+	void Update(float deltaTime);
+	void Draw(Renderer& renderer, const glm::mat4& mvp);
+
+	inline ParticleEmitterSettings& GetSettings() { return m_settings; }
+	inline ParticleSimulation GetSimulation() const { return m_simulation; }
+	inline unsigned int GetCapacity() const { return m_capacity; }
+
+private:
+	void m_InitGPU();
+	void m_InitCPU();
+
+	void m_UpdateCompute(float deltaTime);
+	void m_UpdateTransformFeedback(float deltaTime);
+	void m_UpdateCPU(float deltaTime);
+	void m_SetSimulationUniforms(float deltaTime);
+
+	void m_Respawn(uint32_t index);
+	float m_Random();
+};
@@ -28,3 +28,16 @@ void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader&
     ib.Bind();      // It is a good idea to have an independent buffer array bound at draw call, apparently
     GLCallVoid(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr)); // nullptr here because the buffer is already bound to ibo
 }
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int indexCount)
+{
+    va.Bind();
+    ib.Bind();
+    GLCallVoid(glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr)); // Only the first indexCount indices, the buffer may be larger
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, unsigned int vertexCount, unsigned int instanceCount, const Shader& shader)
+{
+    va.Bind();
+    GLCallVoid(glDrawArraysInstanced(GL_TRIANGLES, 0, vertexCount, instanceCount));
+}
@@ -34,4 +34,6 @@ class Renderer
 public:
     void Clear();
     void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader);
+    void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int indexCount);
+    void DrawInstanced(const VertexArray& va, unsigned int vertexCount, unsigned int instanceCount, const Shader& shader);
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "ResourceManager.h"
+
+#include "Renderer.h"
+
+ResourceManager::~ResourceManager()
+{
+	DestroyAll();
+	EndFrame();
+}
+
+void ResourceManager::DestroyAll()
+{
+	// Vertex arrays go first, since they reference the buffers
+	m_DestroyPool<VertexArray>();
+	m_DestroyPool<VertexBuffer>();
+	m_DestroyPool<IndexBuffer>();
+	m_DestroyPool<Shader>();
+	m_DestroyPool<Texture>();
+}
+
+void ResourceManager::EndFrame()
+{
+	if (!m_pendingVertexArrays.empty())
+	{
+		GLCallVoid(glDeleteVertexArrays((GLsizei)m_pendingVertexArrays.size(), m_pendingVertexArrays.data()));
+		m_pendingVertexArrays.clear();
+	}
+
+	if (!m_pendingBuffers.empty())
+	{
+		GLCallVoid(glDeleteBuffers((GLsizei)m_pendingBuffers.size(), m_pendingBuffers.data()));
+		m_pendingBuffers.clear();
+	}
+
+	if (!m_pendingTextures.empty())
+	{
+		GLCallVoid(glDeleteTextures((GLsizei)m_pendingTextures.size(), m_pendingTextures.data()));
+		m_pendingTextures.clear();
+	}
+
+	// There is no batched version of glDeleteProgram
+	for (unsigned int program : m_pendingPrograms)
+	{
+		GLCallVoid(glDeleteProgram(program));
+	}
+	m_pendingPrograms.clear();
+}
+
+void ResourceManager::m_QueueDeletion(VertexBuffer&& vb)
+{
+	if (unsigned int id = vb.Release())
+	{
+		m_pendingBuffers.push_back(id);
+	}
+}
+
+void ResourceManager::m_QueueDeletion(IndexBuffer&& ib)
+{
+	if (unsigned int id = ib.Release())
+	{
+		m_pendingBuffers.push_back(id);
+	}
+}
+
+void ResourceManager::m_QueueDeletion(VertexArray&& va)
+{
+	if (unsigned int id = va.Release())
+	{
+		m_pendingVertexArrays.push_back(id);
+	}
+}
+
+void ResourceManager::m_QueueDeletion(Shader&& shader)
+{
+	if (unsigned int id = shader.Release())
+	{
+		m_pendingPrograms.push_back(id);
+	}
+}
+
+void ResourceManager::m_QueueDeletion(Texture&& texture)
+{
+	if (unsigned int id = texture.Release())
+	{
+		m_pendingTextures.push_back(id);
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ResourcePool.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "VertexArray.h"
+#include "Shader.h"
+#include "Texture.h"
+
+/*
+* @class	ResourceManager
+* @brief	Owns every GL resource of a scene in pools, one per resource type.
+*			Destroying a resource invalidates its handles right away, but the
+*			GL objects are only deleted in EndFrame(), all of them in a batch.
+*/
+class ResourceManager
+{
+private:
+	std::tuple<
+		ResourcePool<VertexBuffer>,
+		ResourcePool<IndexBuffer>,
+		ResourcePool<VertexArray>,
+		ResourcePool<Shader>,
+		ResourcePool<Texture>> m_pools;
+
+	std::vector<unsigned int> m_pendingBuffers;
+	std::vector<unsigned int> m_pendingVertexArrays;
+	std::vector<unsigned int> m_pendingPrograms;
+	std::vector<unsigned int> m_pendingTextures;
+
+public:
+	ResourceManager() = default;
+	~ResourceManager();
+
+	ResourceManager(const ResourceManager&) = delete;
+	ResourceManager& operator=(const ResourceManager&) = delete;
+
+	template<typename Ty, typename... Args>
+	Handle<Ty> Create(Args&&... args)
+	{
+		return GetPool<Ty>().Create(std::forward<Args>(args)...);
+	}
+
+	template<typename Ty>
+	Ty* Get(Handle<Ty> handle)
+	{
+		return GetPool<Ty>().Get(handle);
+	}
+
+	template<typename Ty>
+	void Destroy(Handle<Ty> handle)
+	{
+		if (GetPool<Ty>().IsAlive(handle))
+		{
+			m_QueueDeletion(GetPool<Ty>().Remove(handle));
+		}
+	}
+
+	template<typename Ty>
+	inline ResourcePool<Ty>& GetPool() { return std::get<ResourcePool<Ty>>(m_pools); }
+
+	// Destroys every resource at once, e.g. when the level changes
+	void DestroyAll();
+
+	// Deletes the GL objects of every resource destroyed since the last call
+	void EndFrame();
+
+private:
+	template<typename Ty>
+	void m_DestroyPool()
+	{
+		for (Ty& resource : GetPool<Ty>().RemoveAll())
+		{
+			m_QueueDeletion(std::move(resource));
+		}
+	}
+
+	void m_QueueDeletion(VertexBuffer&& vb);
+	void m_QueueDeletion(IndexBuffer&& ib);
+	void m_QueueDeletion(VertexArray&& va);
+	void m_QueueDeletion(Shader&& shader);
+	void m_QueueDeletion(Texture&& texture);
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Renderer.h"
+
+/*
+* @struct	Handle
+* @brief	32 bit reference to a resource living in a ResourcePool. The lower
+*			bits index the pool slot and the upper bits hold the generation of
+*			that slot, so a handle to a destroyed resource is detected instead
+*			of silently pointing to whatever took its place.
+*/
+template<typename Ty>
+struct Handle
+{
+	static const uint32_t INDEX_BITS = 20;
+	static const uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+	static const uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+	uint32_t value;
+
+	Handle()
+		: value(0) {}
+	Handle(uint32_t index, uint32_t generation)
+		: value((generation << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+	inline uint32_t GetIndex() const { return value & INDEX_MASK; }
+	inline uint32_t GetGeneration() const { return value >> INDEX_BITS; }
+	inline bool IsValid() const { return value != 0; }
+
+	inline bool operator==(const Handle& other) const { return value == other.value; }
+	inline bool operator!=(const Handle& other) const { return value != other.value; }
+};
+
+/*
+* @class	ResourcePool
+* @brief	Stores resources contiguously and hands out generational handles
+*			to them. Removing a resource moves the last one into its place,
+*			so iterating over the pool never skips holes.
+*/
+template<typename Ty>
+class ResourcePool
+{
+private:
+	struct Slot
+	{
+		uint32_t denseIndex;
+		uint32_t generation;
+	};
+
+	std::vector<Ty> m_resources;
+	std::vector<uint32_t> m_denseToSlot;
+	std::vector<Slot> m_slots;
+	std::vector<uint32_t> m_freeSlots;
+
+public:
+	template<typename... Args>
+	Handle<Ty> Create(Args&&... args)
+	{
+		return Add(Ty(std::forward<Args>(args)...));
+	}
+
+	Handle<Ty> Add(Ty&& resource)
+	{
+		uint32_t slot_index;
+		if (!m_freeSlots.empty())
+		{
+			slot_index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else
+		{
+			ASSERT(m_slots.size() <= Handle<Ty>::INDEX_MASK);
+			slot_index = (uint32_t)m_slots.size();
+			m_slots.push_back({ 0, 1 });	// Generation 0 is reserved for invalid handles
+		}
+
+		Slot& slot = m_slots[slot_index];
+		slot.denseIndex = (uint32_t)m_resources.size();
+		m_resources.push_back(std::move(resource));
+		m_denseToSlot.push_back(slot_index);
+
+		return Handle<Ty>(slot_index, slot.generation);
+	}
+
+	bool IsAlive(Handle<Ty> handle) const
+	{
+		return handle.IsValid() &&
+			handle.GetIndex() < m_slots.size() &&
+			m_slots[handle.GetIndex()].generation == handle.GetGeneration();
+	}
+
+	Ty* Get(Handle<Ty> handle)
+	{
+		return IsAlive(handle) ? &m_resources[m_slots[handle.GetIndex()].denseIndex] : nullptr;
+	}
+
+	const Ty* Get(Handle<Ty> handle) const
+	{
+		return IsAlive(handle) ? &m_resources[m_slots[handle.GetIndex()].denseIndex] : nullptr;
+	}
+
+	/*
+	* Takes the resource out of the pool and invalidates every handle to it.
+	* The caller decides when the returned resource gets destroyed.
+	*/
+	Ty Remove(Handle<Ty> handle)
+	{
+		ASSERT(IsAlive(handle));
+		uint32_t dense_index = m_slots[handle.GetIndex()].denseIndex;
+
+		Ty resource(std::move(m_resources[dense_index]));
+
+		uint32_t last_index = (uint32_t)m_resources.size() - 1;
+		if (dense_index != last_index)
+		{
+			m_resources[dense_index] = std::move(m_resources[last_index]);
+			m_denseToSlot[dense_index] = m_denseToSlot[last_index];
+			m_slots[m_denseToSlot[dense_index]].denseIndex = dense_index;
+		}
+		m_resources.pop_back();
+		m_denseToSlot.pop_back();
+
+		m_RetireSlot(handle.GetIndex());
+
+		return resource;
+	}
+
+	/*
+	* Takes every resource out of the pool at once, invalidating all handles.
+	*/
+	std::vector<Ty> RemoveAll()
+	{
+		for (uint32_t slot_index : m_denseToSlot)
+		{
+			m_RetireSlot(slot_index);
+		}
+		m_denseToSlot.clear();
+
+		std::vector<Ty> resources;
+		resources.swap(m_resources);
+		return resources;
+	}
+
+	inline size_t GetSize() const { return m_resources.size(); }
+
+	inline Ty* begin() { return m_resources.data(); }
+	inline Ty* end() { return m_resources.data() + m_resources.size(); }
+	inline const Ty* begin() const { return m_resources.data(); }
+	inline const Ty* end() const { return m_resources.data() + m_resources.size(); }
+
+private:
+	void m_RetireSlot(uint32_t slotIndex)
+	{
+		// Bumping the generation makes every handle to the old resource stale
+		Slot& slot = m_slots[slotIndex];
+		slot.generation = (slot.generation + 1) & Handle<Ty>::GENERATION_MASK;
+		if (slot.generation == 0)
+		{
+			slot.generation = 1;
+		}
+		m_freeSlots.push_back(slotIndex);
+	}
+};
@@ -8,22 +8,61 @@
 
 #include "Renderer.h"
 
-Shader::Shader(const std::string& filepath)
+Shader::Shader(const std::string& filepath, const std::vector<std::string>& feedbackVaryings)
 {
     ShaderSource shader_source = m_ParseShaderSource(filepath);
 
-    std::cout << "VERTEX\n";
-    std::cout << shader_source.VertexSource << '\n';
-    std::cout << "FRAGMENT\n";
-    std::cout << shader_source.FragmentSource << '\n';
+    if (!shader_source.ComputeSource.empty())
+    {
+        std::cout << "COMPUTE\n";
+        std::cout << shader_source.ComputeSource << '\n';
+    }
+    else
+    {
+        std::cout << "VERTEX\n";
+        std::cout << shader_source.VertexSource << '\n';
+        std::cout << "FRAGMENT\n";
+        std::cout << shader_source.FragmentSource << '\n';
+    }
 
-    m_rendererId = m_CreateShader(shader_source.VertexSource, shader_source.FragmentSource);
+    m_rendererId = m_CreateShader(shader_source, feedbackVaryings);
     GLCallVoid(glUseProgram(m_rendererId));
 }
 
 Shader::~Shader()
 {
-    GLCallVoid(glDeleteProgram(m_rendererId));
+    if (m_rendererId)
+    {
+        GLCallVoid(glDeleteProgram(m_rendererId));
+    }
+}
+
+Shader::Shader(Shader&& other) noexcept
+    :   m_uniformLocationMap(std::move(other.m_uniformLocationMap))
+{
+    m_rendererId = other.Release();
+}
+
+Shader& Shader::operator=(Shader&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_rendererId)
+        {
+            GLCallVoid(glDeleteProgram(m_rendererId));
+        }
+        m_uniformLocationMap = std::move(other.m_uniformLocationMap);
+        m_rendererId = other.Release();
+    }
+    return *this;
+}
+
+unsigned int Shader::Release()
+{
+    unsigned int id = m_rendererId;
+    m_rendererId = 0;
+    m_uniformLocationMap.clear();
+    return id;
 }
 
 void Shader::Bind() const
@@ -42,10 +81,10 @@ ShaderSource Shader::m_ParseShaderSource(const std::string& filepath)
 
     enum class ShaderType
     {
-        NONE = -1, VERTEX = 0, FRAGMENT = 1,
+        NONE = -1, VERTEX = 0, FRAGMENT = 1, COMPUTE = 2,
     };
 
-    std::stringstream ss[2];
+    std::stringstream ss[3];
     ShaderType shader_type = ShaderType::NONE;
 
     std::string line;
@@ -63,6 +102,10 @@ ShaderSource Shader::m_ParseShaderSource(const std::string& filepath)
             {
                 shader_type = ShaderType::FRAGMENT;
             }
+            else if (line.find("compute") != std::string::npos)
+            {
+                shader_type = ShaderType::COMPUTE;
+            }
         }
         else if (shader_type != ShaderType::NONE)
         {
@@ -70,10 +113,10 @@ ShaderSource Shader::m_ParseShaderSource(const std::string& filepath)
         }
     }
 
-    return { ss[0].str(), ss[1].str() };
+    return { ss[0].str(), ss[1].str(), ss[2].str() };
 }
 
-unsigned int Shader::m_CreateShader(const std::string& vertex_shader, const std::string& fragment_shader)
+unsigned int Shader::m_CreateShader(const ShaderSource& source, const std::vector<std::string>& feedbackVaryings)
 {
     /*
     *   Create a program in OpenGL is like generate a buffer,
@@ -83,16 +126,39 @@ unsigned int Shader::m_CreateShader(const std::string& vertex_shader, const std:
     unsigned int program_id = GLCall(glCreateProgram());
 
     /*
-    *   Compile the shaders
+    *   Compile the shaders and attach them, meaning to specify what is going
+    *   to be linked together. A compute shader can not be linked with any other stage.
     */
-    unsigned int vs = m_CompileShader(GL_VERTEX_SHADER, vertex_shader);
-    unsigned int fs = m_CompileShader(GL_FRAGMENT_SHADER, fragment_shader);
+    if (!source.ComputeSource.empty())
+    {
+        unsigned int cs = m_CompileShader(GL_COMPUTE_SHADER, source.ComputeSource);
+        GLCallVoid(glAttachShader(program_id, cs));
+    }
+    else
+    {
+        unsigned int vs = m_CompileShader(GL_VERTEX_SHADER, source.VertexSource);
+        GLCallVoid(glAttachShader(program_id, vs));
+
+        // A program that only feeds transform feedback has nothing to rasterize
+        if (!source.FragmentSource.empty())
+        {
+            unsigned int fs = m_CompileShader(GL_FRAGMENT_SHADER, source.FragmentSource);
+            GLCallVoid(glAttachShader(program_id, fs));
+        }
+    }
 
     /*
-    *   Attach the shaders, meaning to specify what is going to be linked together
+    *   The captured outputs have to be known before linking
     */
-    GLCallVoid(glAttachShader(program_id, vs));
-    GLCallVoid(glAttachShader(program_id, fs));
+    if (!feedbackVaryings.empty())
+    {
+        std::vector<const char*> varyings;
+        for (const std::string& varying : feedbackVaryings)
+        {
+            varyings.push_back(varying.c_str());
+        }
+        GLCallVoid(glTransformFeedbackVaryings(program_id, (GLsizei)varyings.size(), varyings.data(), GL_INTERLEAVED_ATTRIBS));
+    }
 
     /*
     * Actually link the program
@@ -122,7 +188,8 @@ unsigned int Shader::m_CompileShader(unsigned int type, const std::string& sourc
         char* error_message = (char*)alloca(log_length * sizeof(char)); // using alloca function to dynamically allocate this string on the stack (might stack overflow?)
         GLCallVoid(glGetShaderInfoLog(shader_id, log_length, &log_length, error_message));
 
-        std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex shader" : "fragment shader") << "\n";
+        std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex shader" :
+            type == GL_FRAGMENT_SHADER ? "fragment shader" : "compute shader") << "\n";
         std::cout << "Error message: " << error_message << "\n";
         GLCallVoid(glDeleteShader(shader_id));
         return 0;
@@ -156,6 +223,18 @@ void Shader::SetUniform1i(const std::string& name, int value)
     GLCallVoid(glUniform1i(location, value));
 }
 
+void Shader::SetUniform1f(const std::string& name, float value)
+{
+    int location = m_GetUniformLocation(name);
+    GLCallVoid(glUniform1f(location, value));
+}
+
+void Shader::SetUniform3f(const std::string& name, float v0, float v1, float v2)
+{
+    int location = m_GetUniformLocation(name);
+    GLCallVoid(glUniform3f(location, v0, v1, v2));
+}
+
 void Shader::SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3)
 {
     int location = m_GetUniformLocation(name);
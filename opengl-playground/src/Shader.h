@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -9,6 +10,7 @@ struct ShaderSource
 {
 	std::string VertexSource;
 	std::string FragmentSource;
+	std::string ComputeSource;
 };
 
 class Shader
@@ -18,18 +20,34 @@ private:
 	std::unordered_map<std::string, int> m_uniformLocationMap;
 
 public:
-	Shader(const std::string& filepath);
+	/*
+	* A file with a compute section builds a compute program. Otherwise the
+	* fragment section is optional, and the outputs listed in `feedbackVaryings`
+	* are captured with transform feedback.
+	*/
+	Shader(const std::string& filepath, const std::vector<std::string>& feedbackVaryings = {});
 	~Shader();
 
+	Shader(const Shader&) = delete;
+	Shader& operator=(const Shader&) = delete;
+	Shader(Shader&& other) noexcept;
+	Shader& operator=(Shader&& other) noexcept;
+
+	// Gives up ownership of the GL program, so it can be deleted somewhere else
+	unsigned int Release();
+	inline unsigned int GetRendererId() const { return m_rendererId; }
+
 	void Bind() const;
 	void Unbind() const;
 
 	void SetUniform1i(const std::string& name, int value);
+	void SetUniform1f(const std::string& name, float value);
+	void SetUniform3f(const std::string& name, float v0, float v1, float v2);
 	void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
 	void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
 private:
 	ShaderSource m_ParseShaderSource(const std::string& filpath);
-	unsigned int m_CreateShader(const std::string& vertex_shader, const std::string& fragment_shader);
+	unsigned int m_CreateShader(const ShaderSource& source, const std::vector<std::string>& feedbackVaryings);
 	unsigned int m_CompileShader(unsigned int type, const std::string& source);
 
 	int m_GetUniformLocation(const std::string& name);
@@ -0,0 +1,177 @@
+#include "TextRenderer.h"
+
+#include "VertexBufferLayout.h"
+
+static const unsigned int s_initialQuadCapacity = 1024;
+
+static std::vector<unsigned int> BuildQuadIndices(unsigned int quadCount)
+{
+	std::vector<unsigned int> indices(quadCount * 6);
+	for (unsigned int i = 0; i < quadCount; i++)
+	{
+		unsigned int vertex = i * 4;
+		indices[i * 6 + 0] = vertex + 0;
+		indices[i * 6 + 1] = vertex + 1;
+		indices[i * 6 + 2] = vertex + 2;
+		indices[i * 6 + 3] = vertex + 2;
+		indices[i * 6 + 4] = vertex + 3;
+		indices[i * 6 + 5] = vertex + 0;
+	}
+	return indices;
+}
+
+// Returns the codepoint starting at `i` and moves `i` past it. Malformed bytes decode as U+FFFD
+static unsigned int DecodeUtf8(const std::string& text, size_t& i)
+{
+	unsigned char lead = (unsigned char)text[i++];
+	if (lead < 0x80)
+	{
+		return lead;
+	}
+
+	int length = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1;
+	if (length < 0)
+	{
+		return 0xFFFD;
+	}
+
+	unsigned int codepoint = lead & (0x3F >> length);
+	for (int k = 0; k < length; k++)
+	{
+		if (i >= text.size() || ((unsigned char)text[i] & 0xC0) != 0x80)
+		{
+			return 0xFFFD;
+		}
+		codepoint = (codepoint << 6) | ((unsigned char)text[i++] & 0x3F);
+	}
+	return codepoint;
+}
+
+TextRenderer::TextRenderer(const std::string& fontPath, int glyphSize, size_t maxCachedRuns)
+	:	m_font(fontPath),
+		m_atlas(m_font, glyphSize, glyphSize / 8 > 2 ? glyphSize / 8 : 2),
+		m_shader("res/shaders/Text.shader"),
+		m_vertexBuffer(nullptr, s_initialQuadCapacity * 4 * sizeof(TextVertex), GL_STREAM_DRAW),
+		m_indexBuffer(BuildQuadIndices(s_initialQuadCapacity).data(), s_initialQuadCapacity * 6),
+		m_quadCapacity(s_initialQuadCapacity),
+		m_maxCachedRuns(maxCachedRuns)
+{
+	VertexBufferLayout layout;
+	layout.Push<float>(2);
+	layout.Push<float>(2);
+	layout.Push<unsigned char>(4);
+	m_vertexArray.AddBuffer(m_vertexBuffer, layout);
+	m_vertexArray.Unbind();
+}
+
+void TextRenderer::AddText(const std::string& text, float x, float y, float size, const glm::vec4& color)
+{
+	const GlyphRun& run = m_GetRun(text);
+
+	unsigned char r = (unsigned char)(glm::clamp(color.r, 0.0f, 1.0f) * 255.0f);
+	unsigned char g = (unsigned char)(glm::clamp(color.g, 0.0f, 1.0f) * 255.0f);
+	unsigned char b = (unsigned char)(glm::clamp(color.b, 0.0f, 1.0f) * 255.0f);
+	unsigned char a = (unsigned char)(glm::clamp(color.a, 0.0f, 1.0f) * 255.0f);
+
+	for (const AtlasGlyph& glyph : run.Glyphs)
+	{
+		float x0 = x + glyph.X0 * size;
+		float y0 = y + glyph.Y0 * size;
+		float x1 = x + glyph.X1 * size;
+		float y1 = y + glyph.Y1 * size;
+
+		m_vertices.push_back({ x0, y0, glyph.U0, glyph.V0, { r, g, b, a } });
+		m_vertices.push_back({ x1, y0, glyph.U1, glyph.V0, { r, g, b, a } });
+		m_vertices.push_back({ x1, y1, glyph.U1, glyph.V1, { r, g, b, a } });
+		m_vertices.push_back({ x0, y1, glyph.U0, glyph.V1, { r, g, b, a } });
+	}
+}
+
+void TextRenderer::Flush(Renderer& renderer, const glm::mat4& mvp)
+{
+	if (m_vertices.empty())
+	{
+		return;
+	}
+
+	unsigned int quad_count = (unsigned int)(m_vertices.size() / 4);
+
+	// The vertex array has to be bound before a new index buffer is created, so it gets attached to it
+	m_vertexArray.Bind();
+	m_ReserveQuads(quad_count);
+	m_vertexBuffer.SetData(m_vertices.data(), (unsigned int)(m_vertices.size() * sizeof(TextVertex)));
+
+	m_shader.Bind();
+	m_shader.SetUniformMat4f("u_MVP", mvp);
+	m_shader.SetUniform1i("u_Atlas", 0);
+	m_atlas.Bind(0);
+
+	renderer.Draw(m_vertexArray, m_indexBuffer, m_shader, quad_count * 6);
+	m_vertices.clear();
+}
+
+float TextRenderer::MeasureText(const std::string& text, float size)
+{
+	return m_GetRun(text).Width * size;
+}
+
+const GlyphRun& TextRenderer::m_GetRun(const std::string& text)
+{
+	auto search = m_runCache.find(text);
+	if (search != m_runCache.end())
+	{
+		return search->second;
+	}
+
+	// Labels that change every frame would grow the cache forever, start over instead
+	if (m_runCache.size() >= m_maxCachedRuns)
+	{
+		m_runCache.clear();
+	}
+
+	GlyphRun run;
+	run.Width = 0.0f;
+	float pen_x = 0.0f;
+	float pen_y = 0.0f;
+	float line_height = m_font.GetLineHeight();
+
+	size_t i = 0;
+	while (i < text.size())
+	{
+		unsigned int codepoint = DecodeUtf8(text, i);
+		if (codepoint == '\n')
+		{
+			pen_x = 0.0f;
+			pen_y -= line_height;
+			continue;
+		}
+
+		AtlasGlyph glyph = m_atlas.GetGlyph(codepoint);
+		if (glyph.U1 > glyph.U0)
+		{
+			glyph.X0 += pen_x;
+			glyph.X1 += pen_x;
+			glyph.Y0 += pen_y;
+			glyph.Y1 += pen_y;
+			run.Glyphs.push_back(glyph);
+		}
+		pen_x += glyph.Advance;
+		run.Width = pen_x > run.Width ? pen_x : run.Width;
+	}
+
+	return m_runCache.emplace(text, std::move(run)).first->second;
+}
+
+void TextRenderer::m_ReserveQuads(unsigned int quadCount)
+{
+	if (quadCount <= m_quadCapacity)
+	{
+		return;
+	}
+
+	while (m_quadCapacity < quadCount)
+	{
+		m_quadCapacity *= 2;
+	}
+	m_indexBuffer = IndexBuffer(BuildQuadIndices(m_quadCapacity).data(), m_quadCapacity * 6);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Font.h"
+#include "GlyphAtlas.h"
+#include "IndexBuffer.h"
+#include "Renderer.h"
+#include "Shader.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+// A string laid out once, in em relative to its origin, ready to be placed anywhere
+struct GlyphRun
+{
+	std::vector<AtlasGlyph> Glyphs;
+	float Width;
+};
+
+struct TextVertex
+{
+	float X;
+	float Y;
+	float U;
+	float V;
+	unsigned char Color[4];
+};
+
+/*
+* @class	TextRenderer
+* @brief	Draws text with signed distance field glyphs. AddText() only
+*			queues the string, Flush() draws everything queued since the last
+*			flush with a single draw call. Strings are laid out once and cached,
+*			so labels drawn every frame cost one lookup plus their vertices.
+*/
+class TextRenderer
+{
+private:
+	Font m_font;
+	GlyphAtlas m_atlas;
+	Shader m_shader;
+	VertexArray m_vertexArray;
+	VertexBuffer m_vertexBuffer;
+	IndexBuffer m_indexBuffer;
+	unsigned int m_quadCapacity;
+	std::vector<TextVertex> m_vertices;
+	std::unordered_map<std::string, GlyphRun> m_runCache;
+	size_t m_maxCachedRuns;
+
+public:
+	TextRenderer(const std::string& fontPath, int glyphSize = 32, size_t maxCachedRuns = 4096);
+
+	// Queues the text with its baseline starting at (x, y). `size` is the height of an em
+	void AddText(const std::string& text, float x, float y, float size, const glm::vec4& color);
+	void Flush(Renderer& renderer, const glm::mat4& mvp);
+
+	// Width of the text at the given size, without drawing it
+	float MeasureText(const std::string& text, float size);
+
+	inline float GetLineHeight(float size) const
+	{
+		return size * m_font.GetLineHeight();
+	}
+	inline const GlyphAtlas& GetAtlas() const { return m_atlas; }
+	inline size_t GetCachedRunCount() const { return m_runCache.size(); }
+
+private:
+	const GlyphRun& m_GetRun(const std::string& text);
+	void m_ReserveQuads(unsigned int quadCount);
+};
@@ -1,41 +1,223 @@
 #include "Texture.h"
 
+#include <iostream>
+
 #include <stb/stb_image.h>
 
 #include "Renderer.h"
 
-Texture::Texture(const std::string& filepath)
+/*
+* Halves an RGBA8 image in place with a 2x2 box filter. Every destination pixel
+* comes before the source pixels it reads from, so no temporary buffer is needed.
+*/
+static void DownsampleRGBA8(unsigned char* pixels, int& width, int& height)
+{
+	int new_width = width > 1 ? width / 2 : 1;
+	int new_height = height > 1 ? height / 2 : 1;
+
+	for (int y = 0; y < new_height; y++)
+	{
+		int y0 = y * 2;
+		int y1 = (y0 + 1 < height) ? y0 + 1 : y0;
+		for (int x = 0; x < new_width; x++)
+		{
+			int x0 = x * 2;
+			int x1 = (x0 + 1 < width) ? x0 + 1 : x0;
+			for (int c = 0; c < 4; c++)
+			{
+				unsigned int sum = pixels[(y0 * width + x0) * 4 + c] + pixels[(y0 * width + x1) * 4 + c] +
+					pixels[(y1 * width + x0) * 4 + c] + pixels[(y1 * width + x1) * 4 + c];
+				pixels[(y * new_width + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+			}
+		}
+	}
+
+	width = new_width;
+	height = new_height;
+}
+
+Texture::Texture(const std::string& filepath, bool loadNow)
 	:	m_rendererId(0),
 		m_filePath(filepath),
 		m_localBuffer(nullptr),
 		m_width(0),
 		m_height(0),
-		m_bitsPerPixel(0)
+		m_bitsPerPixel(0),
+		m_mipLevelCount(0),
+		m_baseLevel(0)
+{
+	if (loadNow)
+	{
+		Load();
+		return;
+	}
+
+	// Only read the header, so the size of the texture is known before it is uploaded
+	if (stbi_info(filepath.c_str(), &m_width, &m_height, &m_bitsPerPixel))
+	{
+		m_mipLevelCount = ComputeMipLevelCount(m_width, m_height);
+	}
+	else
+	{
+		std::cout << "Failed to read texture " << filepath << ": " << stbi_failure_reason() << "\n";
+	}
+}
+
+Texture::~Texture()
 {
+	Unload();
+}
+
+Texture::Texture(Texture&& other) noexcept
+	:	m_rendererId(other.m_rendererId),
+		m_filePath(std::move(other.m_filePath)),
+		m_localBuffer(nullptr),
+		m_width(other.m_width),
+		m_height(other.m_height),
+		m_bitsPerPixel(other.m_bitsPerPixel),
+		m_mipLevelCount(other.m_mipLevelCount),
+		m_baseLevel(other.m_baseLevel)
+{
+	other.m_rendererId = 0;
+}
+
+Texture& Texture::operator=(Texture&& other) noexcept
+{
+	if (this != &other)
+	{
+		Unload();
+		m_rendererId = other.Release();
+		m_filePath = std::move(other.m_filePath);
+		m_width = other.m_width;
+		m_height = other.m_height;
+		m_bitsPerPixel = other.m_bitsPerPixel;
+		m_mipLevelCount = other.m_mipLevelCount;
+		m_baseLevel = other.m_baseLevel;
+	}
+	return *this;
+}
+
+void Texture::Load(unsigned int baseLevel)
+{
+	Unload();
+
 	stbi_set_flip_vertically_on_load(1);
-	m_localBuffer = stbi_load(filepath.c_str(), &m_width, &m_height, &m_bitsPerPixel, 4);
+	m_localBuffer = stbi_load(m_filePath.c_str(), &m_width, &m_height, &m_bitsPerPixel, 4);
+	if (!m_localBuffer)
+	{
+		std::cout << "Failed to load texture " << m_filePath << ": " << stbi_failure_reason() << "\n";
+		return;
+	}
+
+	m_mipLevelCount = ComputeMipLevelCount(m_width, m_height);
+	if (baseLevel >= m_mipLevelCount)
+	{
+		baseLevel = m_mipLevelCount - 1;
+	}
+
+	// Dropped mip levels are never uploaded, so they cost no VRAM at all
+	int width = m_width;
+	int height = m_height;
+	for (unsigned int level = 0; level < baseLevel; level++)
+	{
+		DownsampleRGBA8(m_localBuffer, width, height);
+	}
 
 	GLCallVoid(glGenTextures(1, &m_rendererId));
 	GLCallVoid(glBindTexture(GL_TEXTURE_2D, m_rendererId));
 
-	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
 	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
 	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
 	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
 
-	GLCallVoid(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, 
+	GLCallVoid(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0,
 		GL_RGBA, GL_UNSIGNED_BYTE, m_localBuffer));
+	GLCallVoid(glGenerateMipmap(GL_TEXTURE_2D));
+	GLCallVoid(glBindTexture(GL_TEXTURE_2D, 0));
+
+	stbi_image_free(m_localBuffer);
+	m_localBuffer = nullptr;
+	m_baseLevel = baseLevel;
+}
+
+void Texture::DropMipLevels(unsigned int baseLevel)
+{
+	if (!IsResident() || baseLevel <= m_baseLevel)
+	{
+		return;
+	}
+	if (baseLevel >= m_mipLevelCount)
+	{
+		baseLevel = m_mipLevelCount - 1;
+	}
+
+	unsigned int skipped = baseLevel - m_baseLevel;
+	unsigned int level_count = m_mipLevelCount - baseLevel;
+
+	unsigned int renderer_id;
+	GLCallVoid(glGenTextures(1, &renderer_id));
+	GLCallVoid(glBindTexture(GL_TEXTURE_2D, renderer_id));
+
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+	GLCallVoid(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+	for (unsigned int level = 0; level < level_count; level++)
+	{
+		GLCallVoid(glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, GetMipDimension(m_width, baseLevel + level),
+			GetMipDimension(m_height, baseLevel + level), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+	}
 	GLCallVoid(glBindTexture(GL_TEXTURE_2D, 0));
 
-	if (m_localBuffer)
+	if (GLEW_VERSION_4_3 || GLEW_ARB_copy_image)
+	{
+		for (unsigned int level = 0; level < level_count; level++)
+		{
+			GLCallVoid(glCopyImageSubData(m_rendererId, GL_TEXTURE_2D, skipped + level, 0, 0, 0,
+				renderer_id, GL_TEXTURE_2D, level, 0, 0, 0,
+				GetMipDimension(m_width, baseLevel + level), GetMipDimension(m_height, baseLevel + level), 1));
+		}
+	}
+	else
 	{
-		stbi_image_free(m_localBuffer);
+		// Before GL 4.3 the levels are copied by blitting between two framebuffers
+		unsigned int framebuffers[2];
+		GLCallVoid(glGenFramebuffers(2, framebuffers));
+		GLCallVoid(glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]));
+		GLCallVoid(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]));
+		for (unsigned int level = 0; level < level_count; level++)
+		{
+			int width = GetMipDimension(m_width, baseLevel + level);
+			int height = GetMipDimension(m_height, baseLevel + level);
+			GLCallVoid(glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_rendererId, skipped + level));
+			GLCallVoid(glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, renderer_id, level));
+			GLCallVoid(glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+		}
+		GLCallVoid(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		GLCallVoid(glDeleteFramebuffers(2, framebuffers));
 	}
+
+	Unload();
+	m_rendererId = renderer_id;
+	m_baseLevel = baseLevel;
 }
 
-Texture::~Texture()
+void Texture::Unload()
 {
-	GLCallVoid(glDeleteTextures(1, &m_rendererId));
+	if (m_rendererId)
+	{
+		GLCallVoid(glDeleteTextures(1, &m_rendererId));
+		m_rendererId = 0;
+	}
+}
+
+unsigned int Texture::Release()
+{
+	unsigned int id = m_rendererId;
+	m_rendererId = 0;
+	return id;
 }
 
 void Texture::Bind(unsigned int slot) const
@@ -48,3 +230,52 @@ void Texture::Unbind() const
 {
 	GLCallVoid(glBindTexture(GL_TEXTURE_2D, 0));
 }
+
+size_t Texture::GetMemorySize() const
+{
+	return IsResident() ? GetMemorySize(m_baseLevel) : 0;
+}
+
+size_t Texture::GetMemorySize(unsigned int baseLevel) const
+{
+	return EstimateMemorySize(m_width, m_height, baseLevel);
+}
+
+size_t Texture::EstimateMemorySize(int width, int height, unsigned int baseLevel)
+{
+	if (width <= 0 || height <= 0)
+	{
+		return 0;
+	}
+
+	// Every texel is stored as GL_RGBA8, i.e. 4 bytes, in every mip level down to 1x1
+	size_t size = 0;
+	unsigned int level = 0;
+	while (true)
+	{
+		if (level >= baseLevel)
+		{
+			size += (size_t)width * (size_t)height * 4;
+		}
+		if (width == 1 && height == 1)
+		{
+			break;
+		}
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+		level++;
+	}
+	return size;
+}
+
+unsigned int Texture::ComputeMipLevelCount(int width, int height)
+{
+	unsigned int count = 1;
+	int size = width > height ? width : height;
+	while (size > 1)
+	{
+		size /= 2;
+		count++;
+	}
+	return count;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 class Texture
@@ -11,15 +12,55 @@ private:
 	int m_width;
 	int m_height;
 	int m_bitsPerPixel;
+	unsigned int m_mipLevelCount;	// Mip levels of the full resolution image
+	unsigned int m_baseLevel;		// How many of the top mip levels were dropped on upload
 
 public:
-	Texture(const std::string &filepath);
+	Texture(const std::string &filepath, bool loadNow = true);
 	~Texture();
 
+	Texture(const Texture&) = delete;
+	Texture& operator=(const Texture&) = delete;
+	Texture(Texture&& other) noexcept;
+	Texture& operator=(Texture&& other) noexcept;
+
+	/*
+	* Uploads the image to the GPU, skipping its `baseLevel` biggest mip levels.
+	* Calling it on a resident texture replaces the previous upload.
+	*/
+	void Load(unsigned int baseLevel = 0);
+	/*
+	* Drops the top mip levels of a resident texture until `baseLevel` is the
+	* biggest one left. The remaining levels are copied on the GPU, so the image
+	* is not read from disk again.
+	*/
+	void DropMipLevels(unsigned int baseLevel);
+	void Unload();
+	// Gives up ownership of the GL texture, so it can be deleted somewhere else
+	unsigned int Release();
+
 	void Bind(unsigned int slot = 0) const;
 	void Unbind() const;
 
 	inline unsigned int GetWidth() const { return m_width; }
 	inline unsigned int GetHeight() const { return m_height; }
-};
+	inline const std::string& GetFilePath() const { return m_filePath; }
+	inline unsigned int GetMipLevelCount() const { return m_mipLevelCount; }
+	inline unsigned int GetBaseLevel() const { return m_baseLevel; }
+	inline bool IsResident() const { return m_rendererId != 0; }
+	inline unsigned int GetRendererId() const { return m_rendererId; }
 
+	// Estimated VRAM used by the texture right now (0 when it is not resident)
+	size_t GetMemorySize() const;
+	// Estimated VRAM the texture would use if loaded with the given base level
+	size_t GetMemorySize(unsigned int baseLevel) const;
+
+	static size_t EstimateMemorySize(int width, int height, unsigned int baseLevel = 0);
+	static unsigned int ComputeMipLevelCount(int width, int height);
+	// Width or height of the given mip level of an image
+	static inline int GetMipDimension(int size, unsigned int level)
+	{
+		size >>= level;
+		return size > 1 ? size : 1;
+	}
+};
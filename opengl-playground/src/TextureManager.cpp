@@ -0,0 +1,275 @@
+#include "TextureManager.h"
+
+#include <algorithm>
+
+TextureManager::TextureManager(size_t budgetBytes, unsigned int maxDroppedLevels, unsigned int idleFrames)
+	:	m_budget(budgetBytes),
+		m_maxDroppedLevels(maxDroppedLevels),
+		m_idleFrames(idleFrames),
+		m_frame(0),
+		m_stats()
+{
+	m_stats.BudgetBytes = budgetBytes;
+}
+
+Texture& TextureManager::Get(const std::string& filepath)
+{
+	auto search = m_entries.find(filepath);
+	if (search == m_entries.end())
+	{
+		m_lru.push_front(filepath);
+
+		search = m_entries.emplace(filepath, Entry(Texture(filepath, false), m_lru.begin())).first;
+	}
+	else
+	{
+		m_lru.splice(m_lru.begin(), m_lru, search->second.lruPosition);
+	}
+
+	Entry& entry = search->second;
+	entry.lastUsedFrame = m_frame;
+	m_MakeResident(entry);
+	return entry.texture;
+}
+
+void TextureManager::Bind(const std::string& filepath, unsigned int slot)
+{
+	Get(filepath).Bind(slot);
+}
+
+void TextureManager::BeginFrame()
+{
+	m_frame++;
+	m_UpgradeTextures();
+}
+
+void TextureManager::SetBudget(size_t budgetBytes)
+{
+	m_budget = budgetBytes;
+	m_stats.BudgetBytes = budgetBytes;
+	if (m_stats.UsedBytes > m_budget)
+	{
+		m_FreeMemory(m_stats.UsedBytes - m_budget);
+	}
+}
+
+void TextureManager::m_MakeResident(Entry& entry)
+{
+	Texture& texture = entry.texture;
+	if (texture.GetMipLevelCount() == 0 || texture.IsResident())
+	{
+		return;
+	}
+
+	// The texture has to be drawn, so when nothing else is left it may evict textures in use,
+	// but it settles for a smaller version of the image rather than doing it
+	size_t free_size = m_budget > m_stats.UsedBytes ? m_budget - m_stats.UsedBytes : 0;
+	unsigned int base_level = m_GetBestBaseLevel(texture, free_size + m_GetReclaimableBytes(true));
+	m_Load(entry, base_level, free_size);
+}
+
+void TextureManager::m_UpgradeTextures()
+{
+	// A texture is only upgraded with memory nobody is using. Taking it from textures
+	// in use would just have them reloaded right after, at the expense of this one
+	size_t idle_size = m_GetReclaimableBytes(false);
+
+	// Textures used in the last frame come first in the LRU list. Upgrading reads the
+	// image from disk again, so at most one of them gets upgraded per frame
+	for (auto it = m_lru.begin(); it != m_lru.end(); ++it)
+	{
+		Entry& entry = m_entries.find(*it)->second;
+		if (m_frame - entry.lastUsedFrame > 1)
+		{
+			break;
+		}
+
+		Texture& texture = entry.texture;
+		if (!texture.IsResident() || texture.GetBaseLevel() == 0)
+		{
+			continue;
+		}
+
+		size_t others_size = m_stats.UsedBytes - texture.GetMemorySize();
+		size_t free_size = m_budget > others_size ? m_budget - others_size : 0;
+		unsigned int base_level = m_GetBestBaseLevel(texture, free_size + idle_size);
+		if (base_level < texture.GetBaseLevel())
+		{
+			m_Load(entry, base_level, free_size);
+			break;
+		}
+	}
+}
+
+unsigned int TextureManager::m_GetBestBaseLevel(const Texture& texture, size_t availableBytes) const
+{
+	unsigned int max_level = m_GetMaxBaseLevel(texture);
+	unsigned int base_level = 0;
+	while (base_level < max_level && texture.GetMemorySize(base_level) > availableBytes)
+	{
+		base_level++;
+	}
+	return base_level;
+}
+
+void TextureManager::m_Load(Entry& entry, unsigned int baseLevel, size_t freeBytes)
+{
+	// Make room before uploading anything, so the upload itself does not push the
+	// usage past the budget
+	Texture& texture = entry.texture;
+	size_t new_size = texture.GetMemorySize(baseLevel);
+	if (new_size > freeBytes)
+	{
+		m_FreeMemory(new_size - freeBytes);
+	}
+
+	size_t old_size = texture.GetMemorySize();
+	texture.Load(baseLevel);
+	if (texture.IsResident())
+	{
+		m_stats.LoadCount++;
+	}
+	m_UpdateUsage(old_size, texture.GetMemorySize());
+}
+
+void TextureManager::m_FreeMemory(size_t bytes)
+{
+	size_t target = m_stats.UsedBytes > bytes ? m_stats.UsedBytes - bytes : 0;
+
+	// Textures that have not been used for a while are the first to go
+	for (auto it = m_lru.rbegin(); it != m_lru.rend() && m_stats.UsedBytes > target; ++it)
+	{
+		Entry& entry = m_entries.find(*it)->second;
+		if (m_IsCandidate(entry) && m_IsIdle(entry))
+		{
+			m_Evict(entry);
+		}
+	}
+
+	// Recently used textures rather lose some mip levels, so they can still be drawn.
+	// When that is not enough, the least recently used are evicted until it is,
+	// so no texture pays for a mip drop and an eviction at once
+	size_t mip_savings = 0;
+	for (const auto& pair : m_entries)
+	{
+		if (m_IsCandidate(pair.second))
+		{
+			mip_savings += m_GetMipSavings(pair.second.texture);
+		}
+	}
+
+	for (auto it = m_lru.rbegin(); it != m_lru.rend() && m_stats.UsedBytes > target + mip_savings; ++it)
+	{
+		Entry& entry = m_entries.find(*it)->second;
+		if (m_IsCandidate(entry))
+		{
+			mip_savings -= m_GetMipSavings(entry.texture);
+			m_Evict(entry);
+		}
+	}
+
+	// Every texture goes straight to the level that covers what is still missing
+	for (auto it = m_lru.rbegin(); it != m_lru.rend() && m_stats.UsedBytes > target; ++it)
+	{
+		Entry& entry = m_entries.find(*it)->second;
+		if (!m_IsCandidate(entry))
+		{
+			continue;
+		}
+
+		Texture& texture = entry.texture;
+		size_t missing = m_stats.UsedBytes - target;
+		unsigned int max_level = m_GetMaxBaseLevel(texture);
+		unsigned int base_level = texture.GetBaseLevel();
+		while (base_level < max_level && texture.GetMemorySize() - texture.GetMemorySize(base_level) < missing)
+		{
+			base_level++;
+		}
+
+		if (base_level > texture.GetBaseLevel())
+		{
+			m_DropMipLevels(entry, base_level);
+		}
+	}
+}
+
+void TextureManager::m_DropMipLevels(Entry& entry, unsigned int baseLevel)
+{
+	size_t old_size = entry.texture.GetMemorySize();
+	unsigned int old_level = entry.texture.GetBaseLevel();
+	entry.texture.DropMipLevels(baseLevel);
+	m_stats.MipDropCount += entry.texture.GetBaseLevel() - old_level;
+	m_UpdateUsage(old_size, entry.texture.GetMemorySize());
+}
+
+void TextureManager::m_Evict(Entry& entry)
+{
+	size_t old_size = entry.texture.GetMemorySize();
+	entry.texture.Unload();
+	m_stats.EvictionCount++;
+	m_UpdateUsage(old_size, 0);
+}
+
+bool TextureManager::m_IsCandidate(const Entry& entry) const
+{
+	return entry.texture.IsResident() && entry.lastUsedFrame != m_frame;
+}
+
+bool TextureManager::m_IsIdle(const Entry& entry) const
+{
+	return m_frame - entry.lastUsedFrame > m_idleFrames;
+}
+
+unsigned int TextureManager::m_GetMaxBaseLevel(const Texture& texture) const
+{
+	return std::min(m_maxDroppedLevels, texture.GetMipLevelCount() - 1);
+}
+
+// Memory a resident texture gives back when it drops every mip level it is allowed to
+size_t TextureManager::m_GetMipSavings(const Texture& texture) const
+{
+	if (!texture.IsResident())
+	{
+		return 0;
+	}
+	return texture.GetMemorySize() - texture.GetMemorySize(std::max(texture.GetBaseLevel(), m_GetMaxBaseLevel(texture)));
+}
+
+// Memory m_FreeMemory() can release without evicting any recently used texture
+size_t TextureManager::m_GetReclaimableBytes(bool dropMipLevels) const
+{
+	size_t bytes = 0;
+	for (const auto& pair : m_entries)
+	{
+		const Entry& entry = pair.second;
+		if (!m_IsCandidate(entry))
+		{
+			continue;
+		}
+
+		if (m_IsIdle(entry))
+		{
+			bytes += entry.texture.GetMemorySize();
+		}
+		else if (dropMipLevels)
+		{
+			bytes += m_GetMipSavings(entry.texture);
+		}
+	}
+	return bytes;
+}
+
+void TextureManager::m_UpdateUsage(size_t oldSize, size_t newSize)
+{
+	if (oldSize == 0 && newSize > 0)
+	{
+		m_stats.ResidentCount++;
+	}
+	else if (oldSize > 0 && newSize == 0)
+	{
+		m_stats.ResidentCount--;
+	}
+
+	m_stats.UsedBytes = m_stats.UsedBytes - oldSize + newSize;
+	m_stats.PeakBytes = std::max(m_stats.PeakBytes, m_stats.UsedBytes);
+}
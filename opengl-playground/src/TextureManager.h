@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "Texture.h"
+
+struct TextureStats
+{
+	size_t BudgetBytes;
+	size_t UsedBytes;
+	size_t PeakBytes;
+	unsigned int ResidentCount;
+	unsigned int LoadCount;
+	unsigned int EvictionCount;
+	unsigned int MipDropCount;
+};
+
+/*
+* @class	TextureManager
+* @brief	Keeps the estimated VRAM used by the textures under a budget.
+*			Textures are loaded on demand and, when the budget is exceeded,
+*			the least recently used ones lose their top mip levels or get
+*			evicted. Evicted textures are loaded again when requested.
+*			Textures requested during the current frame are never touched,
+*			since they might be bound already.
+*/
+class TextureManager
+{
+private:
+	struct Entry
+	{
+		Texture texture;
+		unsigned long long lastUsedFrame;
+		std::list<std::string>::iterator lruPosition;
+
+		Entry(Texture&& texture, std::list<std::string>::iterator lruPosition)
+			: texture(std::move(texture)), lastUsedFrame(0), lruPosition(lruPosition) {}
+	};
+
+	size_t m_budget;
+	unsigned int m_maxDroppedLevels;
+	unsigned int m_idleFrames;
+	unsigned long long m_frame;
+	std::unordered_map<std::string, Entry> m_entries;
+	std::list<std::string> m_lru;	// Most recently used first
+	TextureStats m_stats;
+
+public:
+	TextureManager(size_t budgetBytes, unsigned int maxDroppedLevels = 2, unsigned int idleFrames = 60);
+
+	Texture& Get(const std::string& filepath);
+	void Bind(const std::string& filepath, unsigned int slot = 0);
+
+	// Starts a new frame, in which one texture with dropped mip levels may get them back
+	void BeginFrame();
+
+	void SetBudget(size_t budgetBytes);
+	inline size_t GetBudget() const { return m_budget; }
+	inline const TextureStats& GetStats() const { return m_stats; }
+
+private:
+	void m_MakeResident(Entry& entry);
+	void m_UpgradeTextures();
+	unsigned int m_GetBestBaseLevel(const Texture& texture, size_t availableBytes) const;
+	void m_Load(Entry& entry, unsigned int baseLevel, size_t freeBytes);
+	void m_FreeMemory(size_t bytes);
+	void m_DropMipLevels(Entry& entry, unsigned int baseLevel);
+	void m_Evict(Entry& entry);
+	bool m_IsCandidate(const Entry& entry) const;
+	bool m_IsIdle(const Entry& entry) const;
+	unsigned int m_GetMaxBaseLevel(const Texture& texture) const;
+	size_t m_GetMipSavings(const Texture& texture) const;
+	size_t m_GetReclaimableBytes(bool dropMipLevels) const;
+	void m_UpdateUsage(size_t oldSize, size_t newSize);
+};
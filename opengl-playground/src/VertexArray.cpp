@@ -10,10 +10,39 @@ VertexArray::VertexArray()
 
 VertexArray::~VertexArray()
 {
-	GLCallVoid(glDeleteVertexArrays(1, &m_rendererId));
+	if (m_rendererId)
+	{
+		GLCallVoid(glDeleteVertexArrays(1, &m_rendererId));
+	}
+}
+
+VertexArray::VertexArray(VertexArray&& other) noexcept
+	:	m_rendererId(other.Release())
+{
+}
+
+VertexArray& VertexArray::operator=(VertexArray&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (m_rendererId)
+		{
+			GLCallVoid(glDeleteVertexArrays(1, &m_rendererId));
+		}
+		m_rendererId = other.Release();
+	}
+	return *this;
+}
+
+unsigned int VertexArray::Release()
+{
+	unsigned int id = m_rendererId;
+	m_rendererId = 0;
+	return id;
 }
 
-void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
+void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout,
+	unsigned int firstAttribute, unsigned int divisor)
 {
 	Bind();
 	vb.Bind();
@@ -22,9 +51,11 @@ void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& la
 	for (unsigned int i = 0; i < elements.size(); i++)
 	{
 		const auto& element = elements[i];
-		GLCallVoid(glEnableVertexAttribArray(i));
-		GLCallVoid(glVertexAttribPointer(i, element.count, element.type, element.normalized, 
+		unsigned int attribute = firstAttribute + i;
+		GLCallVoid(glEnableVertexAttribArray(attribute));
+		GLCallVoid(glVertexAttribPointer(attribute, element.count, element.type, element.normalized, 
 			layout.GetStride(), (const void*)offset));
+		GLCallVoid(glVertexAttribDivisor(attribute, divisor));
 		offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
 	}
 }
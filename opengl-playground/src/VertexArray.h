@@ -13,7 +13,21 @@ public:
 	VertexArray();
 	~VertexArray();
 
-	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+	VertexArray(const VertexArray&) = delete;
+	VertexArray& operator=(const VertexArray&) = delete;
+	VertexArray(VertexArray&& other) noexcept;
+	VertexArray& operator=(VertexArray&& other) noexcept;
+
+	// Gives up ownership of the GL vertex array, so it can be deleted somewhere else
+	unsigned int Release();
+	inline unsigned int GetRendererId() const { return m_rendererId; }
+
+	/*
+	* Attributes of the layout are numbered from `firstAttribute`. A non-zero
+	* `divisor` makes them advance once per instance instead of once per vertex.
+	*/
+	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout,
+		unsigned int firstAttribute = 0, unsigned int divisor = 0);
 
 	void Bind() const;
 	void Unbind() const;
@@ -3,6 +3,12 @@
 #include "Renderer.h"
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+    :   VertexBuffer(data, size, GL_STATIC_DRAW)
+{
+}
+
+VertexBuffer::VertexBuffer(const void* data, unsigned int size, unsigned int usage)
+    :   m_usage(usage)
 {
     // Generate an internal buffer and assign an index to it
     GLCallVoid(glGenBuffers(1, &m_rendererId));
@@ -11,12 +17,42 @@ VertexBuffer::VertexBuffer(const void* data, unsigned int size)
     GLCallVoid(glBindBuffer(GL_ARRAY_BUFFER, m_rendererId));
 
     // Create the actual buffer of data, specifying at least its size
-    GLCallVoid(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    GLCallVoid(glBufferData(GL_ARRAY_BUFFER, size, data, m_usage));
 }
 
 VertexBuffer::~VertexBuffer()
 {
-    GLCallVoid(glDeleteBuffers(1, &m_rendererId));
+    if (m_rendererId)
+    {
+        GLCallVoid(glDeleteBuffers(1, &m_rendererId));
+    }
+}
+
+VertexBuffer::VertexBuffer(VertexBuffer&& other) noexcept
+    :   m_rendererId(other.Release()),
+        m_usage(other.m_usage)
+{
+}
+
+VertexBuffer& VertexBuffer::operator=(VertexBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_rendererId)
+        {
+            GLCallVoid(glDeleteBuffers(1, &m_rendererId));
+        }
+        m_rendererId = other.Release();
+        m_usage = other.m_usage;
+    }
+    return *this;
+}
+
+unsigned int VertexBuffer::Release()
+{
+    unsigned int id = m_rendererId;
+    m_rendererId = 0;
+    return id;
 }
 
 void VertexBuffer::Bind() const
@@ -28,3 +64,9 @@ void VertexBuffer::Unbind() const
 {
     GLCallVoid(glBindBuffer(GL_ARRAY_BUFFER, 0));
 }
+
+void VertexBuffer::SetData(const void* data, unsigned int size)
+{
+    GLCallVoid(glBindBuffer(GL_ARRAY_BUFFER, m_rendererId));
+    GLCallVoid(glBufferData(GL_ARRAY_BUFFER, size, data, m_usage));
+}
@@ -4,11 +4,25 @@ class VertexBuffer
 {
 private:
 	unsigned int m_rendererId;
+	unsigned int m_usage;
 
 public:
 	VertexBuffer(const void* data, unsigned int size);
+	VertexBuffer(const void* data, unsigned int size, unsigned int usage);
 	~VertexBuffer();
 
+	VertexBuffer(const VertexBuffer&) = delete;
+	VertexBuffer& operator=(const VertexBuffer&) = delete;
+	VertexBuffer(VertexBuffer&& other) noexcept;
+	VertexBuffer& operator=(VertexBuffer&& other) noexcept;
+
+	// Gives up ownership of the GL buffer, so it can be deleted somewhere else
+	unsigned int Release();
+	inline unsigned int GetRendererId() const { return m_rendererId; }
+
 	void Bind() const;
 	void Unbind() const;
+
+	// Replaces the whole buffer. The old storage is orphaned, so the GPU can keep reading it
+	void SetData(const void* data, unsigned int size);
 };
\ No newline at end of file
@@ -0,0 +1,5 @@
+// The header is optional, see Font.cpp
+#if __has_include(<stb/stb_truetype.h>)
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb/stb_truetype.h>
+#endif
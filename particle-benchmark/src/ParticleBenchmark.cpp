@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ParticleKernels.h"
+
+/*
+* Times the CPU particle kernels of opengl-playground on their own, without
+* any window or GL context. Usage: particle-benchmark [particles] [steps]
+*/
+
+static void FillParticles(ParticleArrays& particles, size_t count)
+{
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	particles.Resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		particles.PositionX[i] = unit(rng) * 100.0f;
+		particles.PositionY[i] = unit(rng) * 100.0f;
+		particles.PositionZ[i] = 0.0f;
+		particles.VelocityX[i] = unit(rng) * 50.0f;
+		particles.VelocityY[i] = unit(rng) * 50.0f;
+		particles.VelocityZ[i] = 0.0f;
+		particles.Life[i] = unit(rng) * 2.0f;
+	}
+}
+
+static void Respawn(ParticleArrays& particles, const uint32_t* indices, size_t count)
+{
+	// Kept trivial, so the numbers are about the kernels and not about the emitter
+	for (size_t i = 0; i < count; i++)
+	{
+		uint32_t index = indices[i];
+		particles.PositionX[index] = 0.0f;
+		particles.PositionY[index] = 0.0f;
+		particles.VelocityY[index] = 50.0f;
+		particles.Life[index] = 2.0f;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t count = argc > 1 ? (size_t)std::strtoull(argv[1], nullptr, 10) : (size_t)1 << 20;
+	int steps = argc > 2 ? std::atoi(argv[2]) : 200;
+
+	ParticleStepParams params = { 1.0f / 60.0f, 0.0f, -9.8f, 0.0f };
+	SimdLevel best = DetectSimdLevel();
+	std::cout << count << " particles, " << steps << " steps, best SIMD level: " << GetSimdLevelName(best) << "\n";
+
+	std::vector<uint32_t> respawned(count);
+	std::vector<float> packed(count * 4);
+	ParticleArrays reference;
+
+	for (int level = 0; level <= (int)best; level++)
+	{
+		SimdLevel simd = (SimdLevel)level;
+		ParticleArrays particles;
+		FillParticles(particles, count);
+
+		size_t respawned_total = 0;
+		double integrate_ms = 0.0;
+		double pack_ms = 0.0;
+		for (int step = 0; step < steps; step++)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			size_t respawned_count = IntegrateParticles(simd, particles, params, respawned.data());
+			auto integrated = std::chrono::high_resolution_clock::now();
+			Respawn(particles, respawned.data(), respawned_count);
+			auto respawn_done = std::chrono::high_resolution_clock::now();
+			PackParticlePositionLife(simd, particles, packed.data());
+			auto packed_done = std::chrono::high_resolution_clock::now();
+
+			integrate_ms += std::chrono::duration<double, std::milli>(integrated - start).count();
+			pack_ms += std::chrono::duration<double, std::milli>(packed_done - respawn_done).count();
+			respawned_total += respawned_count;
+		}
+
+		// Every level has to end up with the same particles as the scalar one
+		float max_error = 0.0f;
+		if (simd == SimdLevel::Scalar)
+		{
+			reference = particles;
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				max_error = std::fmax(max_error, std::fabs(particles.PositionX[i] - reference.PositionX[i]));
+				max_error = std::fmax(max_error, std::fabs(particles.PositionY[i] - reference.PositionY[i]));
+				max_error = std::fmax(max_error, std::fabs(particles.Life[i] - reference.Life[i]));
+			}
+		}
+
+		double integrate_per_step = integrate_ms / steps;
+		std::cout << GetSimdLevelName(simd) << ":\n";
+		std::cout << "    integrate " << integrate_per_step << " ms/step ("
+			<< (count / integrate_per_step) / 1000.0 << " M particles/s)\n";
+		std::cout << "    pack      " << pack_ms / steps << " ms/step\n";
+		std::cout << "    respawned " << respawned_total << ", max error vs scalar " << max_error << "\n";
+	}
+
+	return 0;
+}